@@ -3,6 +3,8 @@
 //(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 #include "common.h"
+#include "../source/ecs/mapped_storage_types.h"
+#include "../source/ecs/gap_buffer.h"
 #include <benchmark/benchmark.h>
 
 #include <iostream>
@@ -10,6 +12,12 @@
 #include <iomanip>
 #include <vector>
 #include <chrono>
+#include <numeric>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include <sys/resource.h>
 
 static void opt_escape(void* p)
 {
@@ -164,6 +172,765 @@ void test_container_performance_assign_more(Container& arr)
         opt_clobber();
 }
 
+template <typename Container>
+void test_container_allocations_short_lived(benchmark::State& state)
+{
+        allocation_count = 0;
+        while(state.KeepRunning())
+        {
+                Container arr;
+                opt_escape(arr.data());
+
+                for(auto i = state.range(0); i > 0; --i)
+                        arr.emplace_back(static_cast<int>(i));
+
+                opt_clobber();
+        }
+
+        state.counters["allocations"] = benchmark::Counter(
+                static_cast<double>(allocation_count), benchmark::Counter::kAvgIterations);
+}
+
+template <typename Container>
+void test_container_performance_insert_erase_middle(benchmark::State& state)
+{
+        using value_type = typename Container::value_type;
+        auto n = static_cast<typename Container::size_type>(state.range(0));
+
+        Container arr(n);
+        opt_escape(arr.data());
+
+        while(state.KeepRunning())
+        {
+                arr.insert(arr.begin() + state.range(0) / 2, value_type{});
+                arr.erase(arr.begin() + state.range(0) / 2);
+                opt_clobber();
+        }
+}
+
+template <typename Container>
+void test_container_latency_emplace_back(benchmark::State& state)
+{
+        using clock = std::chrono::steady_clock;
+        auto worst = clock::duration::zero();
+
+        while(state.KeepRunning())
+        {
+                Container arr;
+                opt_escape(arr.data());
+
+                for(auto i = state.range(0); i > 0; --i)
+                {
+                        auto start = clock::now();
+                        arr.emplace_back(static_cast<int>(i));
+                        worst = std::max(worst, clock::now() - start);
+                }
+
+                opt_clobber();
+        }
+
+        state.counters["worst_ns"] = static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(worst).count());
+}
+
+// measures latency of each emplace_back into a container, which is created by the given function
+// with the expected number of elements (percentiles of latency distribution are reported)
+template <typename Factory>
+void test_container_latency_distribution(benchmark::State& state, Factory make)
+{
+        using clock = std::chrono::steady_clock;
+
+        auto n = static_cast<std::size_t>(state.range(0));
+        std::vector<clock::duration> latencies;
+        latencies.reserve(n * 64);
+
+        while(state.KeepRunning())
+        {
+                auto arr = make(n);
+                opt_escape(arr.data());
+
+                for(std::size_t i = 0; i < n; ++i)
+                {
+                        auto start = clock::now();
+                        arr.emplace_back(static_cast<int>(i));
+                        auto latency = clock::now() - start;
+
+                        if(latencies.size() < latencies.capacity())
+                                latencies.push_back(latency);
+                }
+
+                opt_clobber();
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        auto percentile = [&latencies](double p) {
+                auto i = static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1));
+                return static_cast<double>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(latencies[i])
+                                .count());
+        };
+
+        state.counters["p50_ns"] = percentile(0.5);
+        state.counters["p99_ns"] = percentile(0.99);
+        state.counters["p999_ns"] = percentile(0.999);
+        state.counters["worst_ns"] = percentile(1.0);
+}
+
+template <typename Container>
+void test_container_performance_grow(benchmark::State& state)
+{
+        while(state.KeepRunning())
+        {
+                Container arr;
+                arr.resize(std::size_t{1} << 20);
+
+                while(arr.size() < static_cast<std::size_t>(state.range(0)))
+                {
+                        arr.resize(arr.size() + arr.size());
+                        opt_escape(arr.data());
+                }
+
+                opt_clobber();
+        }
+
+        // note: peak resident set size is reported for the whole process
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        state.counters["peak_rss_mb"] = static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+template <typename Container>
+void test_container_growth_policy(benchmark::State& state)
+{
+        using value_type = typename Container::value_type;
+        std::size_t reallocations{}, copied{}, slack{};
+
+        while(state.KeepRunning())
+        {
+                Container arr;
+                opt_escape(arr.data());
+
+                reallocations = copied = 0;
+                for(auto i = state.range(0); i > 0; --i)
+                {
+                        auto capacity = arr.capacity();
+                        arr.emplace_back(static_cast<int>(i));
+
+                        if(arr.capacity() != capacity)
+                                ++reallocations, copied += (arr.size() - 1) * sizeof(value_type);
+                }
+
+                slack = (arr.capacity() - arr.size()) * sizeof(value_type);
+                opt_clobber();
+        }
+
+        state.counters["reallocations"] = static_cast<double>(reallocations);
+        state.counters["bytes_copied"] = static_cast<double>(copied);
+        state.counters["slack_bytes"] = static_cast<double>(slack);
+}
+
+template <typename Container>
+void test_container_performance_push_back(benchmark::State& state)
+{
+        using value_type = typename Container::value_type;
+        auto x = value_type{};
+
+        while(state.KeepRunning())
+        {
+                Container arr;
+                opt_escape(arr.data());
+
+                for(auto i = state.range(0); i > 0; --i)
+                        arr.push_back(x);
+
+                opt_clobber();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// reads a temporary file of the given size into a container, which is resized by the given
+// function before reading
+template <typename Resize>
+void test_container_read_file(benchmark::State& state, Resize resize)
+{
+        auto n = static_cast<std::size_t>(state.range(0));
+
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{std::tmpfile(), std::fclose};
+        if(!file)
+        {
+                state.SkipWithError("could not create temporary file");
+                return;
+        }
+
+        std::vector<unsigned char> data(n, 0x5A);
+        std::fwrite(data.data(), 1, n, file.get());
+
+        while(state.KeepRunning())
+        {
+                ecs::vector<unsigned char> arr;
+                resize(arr, n);
+
+                std::rewind(file.get());
+                if(std::fread(arr.data(), 1, n, file.get()) != n)
+                {
+                        state.SkipWithError("could not read temporary file");
+                        return;
+                }
+
+                opt_escape(arr.data());
+                opt_clobber();
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// 64-byte trivially copyable element
+struct record64
+{
+        std::uint64_t data[8];
+};
+
+template <typename Container>
+void test_container_performance_copy(benchmark::State& state)
+{
+        Container src(static_cast<std::size_t>(state.range(0)));
+
+        while(state.KeepRunning())
+        {
+                Container arr{src};
+                opt_escape(arr.data());
+                opt_clobber();
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0) *
+                                static_cast<std::int64_t>(sizeof(typename Container::value_type)));
+}
+
+template <typename Container>
+void test_container_performance_assign(benchmark::State& state)
+{
+        Container src(static_cast<std::size_t>(state.range(0))), arr;
+        arr.reserve(src.size());
+
+        while(state.KeepRunning())
+        {
+                arr.assign(src.data(), src.data() + src.size());
+                opt_escape(arr.data());
+                opt_clobber();
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0) *
+                                static_cast<std::int64_t>(sizeof(typename Container::value_type)));
+}
+
+// allocator, which constructs elements one at a time (disables bytewise paths of ecs::vector)
+template <typename T>
+struct elementwise_allocator : std::allocator<T>
+{
+        template <typename U>
+        struct rebind
+        {
+                using other = elementwise_allocator<U>;
+        };
+
+        template <typename... Args>
+        void construct(T* location, Args&&... args)
+        {
+                ::new((void*)location) T(std::forward<Args>(args)...);
+        }
+};
+
+// 16-byte trivially copyable element
+struct record16
+{
+        std::uint32_t data[4];
+};
+
+template <typename Container, typename Fill>
+void test_container_performance_fill(benchmark::State& state, Fill fill)
+{
+        using value_type = typename Container::value_type;
+
+        value_type x{};
+        std::memset(static_cast<void*>(std::addressof(x)), 0x5A, sizeof(x));
+        reinterpret_cast<unsigned char*>(std::addressof(x))[0] = 0x01;
+
+        Container arr;
+        arr.reserve(static_cast<std::size_t>(state.range(0)));
+
+        while(state.KeepRunning())
+        {
+                arr.clear();
+                fill(arr, static_cast<std::size_t>(state.range(0)), x);
+
+                opt_escape(arr.data());
+                opt_clobber();
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0) *
+                                static_cast<std::int64_t>(sizeof(value_type)));
+}
+
+// fill operations
+struct fill_assign
+{
+        template <typename Container, typename T>
+        void operator()(Container& arr, std::size_t n, const T& x) const
+        {
+                arr.assign(n, x);
+        }
+};
+
+struct fill_insert
+{
+        template <typename Container, typename T>
+        void operator()(Container& arr, std::size_t n, const T& x) const
+        {
+                arr.insert(arr.end(), n, x);
+        }
+};
+
+struct fill_resize
+{
+        template <typename Container, typename T>
+        void operator()(Container& arr, std::size_t n, const T& x) const
+        {
+                arr.resize(n, x);
+        }
+};
+
+// compares equal containers of the given size in bytes
+template <typename Container, typename Compare>
+void test_container_performance_compare(benchmark::State& state, Compare compare)
+{
+        using value_type = typename Container::value_type;
+
+        auto n = static_cast<std::size_t>(state.range(0)) / sizeof(value_type);
+        Container x(n), y(n);
+
+        for(std::size_t i = 0; i < n; ++i)
+                x[i] = y[i] = static_cast<value_type>(i);
+
+        while(state.KeepRunning())
+        {
+                opt_escape(x.data()), opt_escape(y.data());
+                benchmark::DoNotOptimize(compare(x, y));
+                opt_clobber();
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// hands elements of a staging inplace_vector over to ecs::vector with the given function
+template <typename T, typename Transfer>
+void test_container_performance_handover(benchmark::State& state, Transfer transfer)
+{
+        ecs::inplace_vector<T, 1024> staging;
+        ecs::vector<T> arr;
+        arr.reserve(staging.capacity());
+
+        while(state.KeepRunning())
+        {
+                staging.resize(static_cast<std::size_t>(state.range(0)));
+                opt_escape(staging.data());
+
+                transfer(arr, staging);
+                opt_escape(arr.data());
+                opt_clobber();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// appends elements to an empty container with the given function
+template <typename Container, typename Append>
+void test_container_performance_append(benchmark::State& state, Append append)
+{
+        std::vector<typename Container::value_type> src(static_cast<std::size_t>(state.range(0)));
+        std::iota(src.begin(), src.end(), 0);
+
+        while(state.KeepRunning())
+        {
+                Container arr;
+                append(arr, src);
+
+                opt_escape(arr.data());
+                opt_clobber();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// inserts streamed elements into the middle of a large container (inserted elements are
+// erased afterwards)
+template <typename Container>
+void test_container_performance_insert_streamed(benchmark::State& state)
+{
+        std::vector<int> src(static_cast<std::size_t>(state.range(1)));
+        std::iota(src.begin(), src.end(), 0);
+
+        Container arr(static_cast<std::size_t>(state.range(0)));
+
+        while(state.KeepRunning())
+        {
+                auto position = arr.begin() + state.range(0) / 2;
+                position = arr.insert(position, make_input_iterator(src.data()),
+                                      make_input_iterator(src.data() + src.size()));
+
+                opt_escape(arr.data());
+                arr.erase(position, position + state.range(1));
+                opt_clobber();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+// erases state.range(1) evenly scattered elements from a container of state.range(0) elements
+// (container is refilled between iterations with timing paused)
+template <typename Container, typename Eraser>
+void test_container_performance_erase_scattered(benchmark::State& state, Eraser erase)
+{
+        auto n = static_cast<std::size_t>(state.range(0));
+        auto k = static_cast<std::size_t>(state.range(1));
+
+        std::vector<int> src(n);
+        std::iota(src.begin(), src.end(), 0);
+
+        std::vector<std::size_t> indices(k);
+        for(std::size_t i = 0; i < k; ++i)
+                indices[i] = i * (n / k);
+
+        Container arr;
+        arr.reserve(n);
+
+        while(state.KeepRunning())
+        {
+                state.PauseTiming();
+                arr.assign(src.begin(), src.end());
+                state.ResumeTiming();
+
+                erase(arr, indices);
+
+                opt_escape(arr.data());
+                opt_clobber();
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+// erasure strategies (indices are sorted; element values are equal to their initial indices)
+struct repeated_erase
+{
+        template <typename Container>
+        void operator()(Container& arr, const std::vector<std::size_t>& indices) const
+        {
+                for(auto i = indices.rbegin(); i != indices.rend(); ++i)
+                        arr.erase(arr.begin() + static_cast<std::ptrdiff_t>(*i));
+        }
+};
+
+struct remove_if_erase
+{
+        template <typename Container>
+        void operator()(Container& arr, const std::vector<std::size_t>& indices) const
+        {
+                auto step = static_cast<int>(indices.size() > 1 ? indices[1] : arr.size());
+                arr.erase(std::remove_if(arr.begin(), arr.end(),
+                                         [step](int x) { return x % step == 0; }),
+                          arr.end());
+        }
+};
+
+struct predicate_erase
+{
+        template <typename Container>
+        void operator()(Container& arr, const std::vector<std::size_t>& indices) const
+        {
+                auto step = static_cast<int>(indices.size() > 1 ? indices[1] : arr.size());
+                ecs::erase_if(arr, [step](int x) { return x % step == 0; });
+        }
+};
+
+struct indexed_erase
+{
+        template <typename Container>
+        void operator()(Container& arr, const std::vector<std::size_t>& indices) const
+        {
+                ecs::erase_indices(arr, indices);
+        }
+};
+
+struct unordered_erase
+{
+        template <typename Container>
+        void operator()(Container& arr, const std::vector<std::size_t>& indices) const
+        {
+                for(auto i = indices.rbegin(); i != indices.rend(); ++i)
+                        arr.erase_unordered(arr.begin() + static_cast<std::ptrdiff_t>(*i));
+        }
+};
+
+// returns current resident set size of the process in megabytes
+inline double current_rss_mb()
+{
+        long pages = 0, resident = 0;
+
+        if(auto f = std::fopen("/proc/self/statm", "r"))
+        {
+                if(std::fscanf(f, "%ld %ld", &pages, &resident) != 2)
+                        resident = 0;
+
+                std::fclose(f);
+        }
+
+        return static_cast<double>(resident) * static_cast<double>(ecs::detail::page_size()) /
+               (1024.0 * 1024.0);
+}
+
+// fills a container with state.range(0) elements, erases all but 1% of them, and releases
+// unused memory (resident set size is reported before and after shrinking)
+template <typename Container>
+void test_container_shrink_to_fit(benchmark::State& state)
+{
+        auto n = static_cast<std::size_t>(state.range(0));
+        double rss_before = 0.0, rss_after = 0.0;
+
+        while(state.KeepRunning())
+        {
+                state.PauseTiming();
+                {
+                        Container arr;
+                        arr.resize(n);
+                        opt_escape(arr.data());
+                        arr.erase(arr.begin() + static_cast<std::ptrdiff_t>(n / 100), arr.end());
+                        rss_before = current_rss_mb();
+                        state.ResumeTiming();
+
+                        arr.shrink_to_fit();
+                        opt_escape(arr.data());
+
+                        state.PauseTiming();
+                        rss_after = current_rss_mb();
+                }
+                state.ResumeTiming();
+        }
+
+        state.counters["rss_before_mb"] = rss_before;
+        state.counters["rss_after_mb"] = rss_after;
+}
+
+// sums elements of state.range(0) small containers, which are stored in an array (each container
+// holds up to 7 bytes, and the array size is reported)
+template <typename Container>
+void test_small_containers_iteration(benchmark::State& state)
+{
+        auto n = static_cast<std::size_t>(state.range(0));
+        std::vector<Container> arr(n);
+
+        for(std::size_t i = 0; i < n; ++i)
+                for(std::size_t k = 0; k < i % 8; ++k)
+                        arr[i].push_back(static_cast<std::uint8_t>(k));
+
+        opt_escape(arr.data());
+
+        while(state.KeepRunning())
+        {
+                unsigned sum = 0;
+                for(auto& c : arr)
+                        for(auto x : c)
+                                sum += x;
+
+                benchmark::DoNotOptimize(sum);
+        }
+
+        state.counters["array_mb"] =
+                static_cast<double>(n * sizeof(Container)) / (1024.0 * 1024.0);
+}
+
+// fills an array of state.range(0) containers, each 16th of which holds up to 8 elements (the
+// rest are empty), and sums all elements (memory used by the array and its elements is reported)
+template <typename Container>
+void test_sparse_containers_iteration(benchmark::State& state)
+{
+        auto n = static_cast<std::size_t>(state.range(0));
+
+        auto rss_before = current_rss_mb();
+        std::vector<Container> arr(n);
+
+        for(std::size_t i = 0; i < n; i += 16)
+                for(std::size_t k = 0; k <= (i / 16) % 8; ++k)
+                        arr[i].push_back(static_cast<int>(k));
+
+        opt_escape(arr.data());
+        auto rss_after = current_rss_mb();
+
+        while(state.KeepRunning())
+        {
+                int sum = 0;
+                for(auto& c : arr)
+                        for(auto x : c)
+                                sum += x;
+
+                benchmark::DoNotOptimize(sum);
+        }
+
+        state.counters["memory_mb"] = rss_after - rss_before;
+}
+
+// builds a container of state.range(0) elements, each of which is inserted at the front with
+// the given function
+template <typename Container, typename PushFront>
+void test_container_prepend(benchmark::State& state, PushFront push_front)
+{
+        auto n = static_cast<int>(state.range(0));
+
+        while(state.KeepRunning())
+        {
+                Container arr;
+                for(int i = 0; i < n; ++i)
+                        push_front(arr, i);
+
+                opt_escape(arr.data());
+        }
+}
+
+// keeps a window of state.range(0) elements: each step removes the oldest element with the given
+// function, and appends a new one
+template <typename Container, typename PopFront>
+void test_container_sliding_window(benchmark::State& state, PopFront pop_front)
+{
+        auto n = static_cast<int>(state.range(0));
+
+        Container arr;
+        for(int i = 0; i < n; ++i)
+                arr.push_back(i);
+
+        int i = n;
+        while(state.KeepRunning())
+        {
+                pop_front(arr);
+                arr.push_back(i++);
+                opt_escape(arr.data());
+        }
+}
+
+// editing operation: insertion of a character at the given position, or erasure of the
+// character at it (if c is 0)
+struct text_edit
+{
+        std::size_t position;
+        char c;
+};
+
+// makes a trace of n edits of a document of the given size: most edits happen at the cursor
+// (typing and backspacing), which occasionally jumps to a random position
+inline std::vector<text_edit> make_editing_trace(std::size_t document_size, std::size_t n)
+{
+        std::minstd_rand rng{42};
+        std::vector<text_edit> trace;
+        trace.reserve(n);
+
+        std::size_t cursor = document_size / 2;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+                auto r = rng() % 256;
+
+                if(r == 0)
+                        cursor = rng() % (document_size + 1);
+
+                if(r < 192 || cursor == 0)
+                        trace.push_back({cursor++, static_cast<char>('a' + r % 26)}),
+                                ++document_size;
+                else
+                        trace.push_back({--cursor, 0}), --document_size;
+        }
+
+        return trace;
+}
+
+inline void apply_edit(ecs::vector<char>& arr, const text_edit& e)
+{
+        auto position = arr.begin() + static_cast<std::ptrdiff_t>(e.position);
+
+        if(e.c != 0)
+                arr.insert(position, e.c);
+        else
+                arr.erase(position);
+}
+
+inline void apply_edit(ecs::gap_buffer<char>& arr, const text_edit& e)
+{
+        if(e.c != 0)
+                arr.insert(e.position, e.c);
+        else
+                arr.erase(e.position);
+}
+
+// replays a trace of 16K edits on a document of state.range(0) characters
+template <typename Container>
+void test_container_editing_trace(benchmark::State& state)
+{
+        auto n = static_cast<std::size_t>(state.range(0));
+        auto trace = make_editing_trace(n, 1 << 14);
+
+        while(state.KeepRunning())
+        {
+                state.PauseTiming();
+                Container arr;
+                for(std::size_t i = 0; i < n; ++i)
+                        apply_edit(arr, {i, 'x'});
+                state.ResumeTiming();
+
+                for(auto& e : trace)
+                        apply_edit(arr, e);
+
+                opt_escape(&arr);
+        }
+}
+
+#if __cpp_constexpr >= 201907L
+// lookup table for CRC-32 (can be built either at compile time, or at program startup)
+constexpr ecs::inplace_vector<std::uint32_t, 256> make_crc32_table()
+{
+        ecs::inplace_vector<std::uint32_t, 256> table;
+
+        for(std::uint32_t i = 0; i < 256; ++i)
+        {
+                auto x = i;
+                for(int k = 0; k < 8; ++k)
+                        x = (x & 1u) ? (x >> 1) ^ 0xEDB88320u : (x >> 1);
+
+                table.push_back(x);
+        }
+
+        return table;
+}
+
+constexpr auto crc32_table = make_crc32_table();
+
+inline std::uint32_t crc32(const ecs::inplace_vector<std::uint32_t, 256>& table,
+                           const unsigned char* data, std::size_t n)
+{
+        std::uint32_t crc = 0xFFFFFFFFu;
+        for(std::size_t i = 0; i < n; ++i)
+                crc = table[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8);
+
+        return ~crc;
+}
+#endif
+
+// fast path of push_back for inspection of generated code (the loop body should contain a
+// single compare and a store, with the call to the slow path placed out of line), e.g.:
+// objdump -d --no-show-raw-insn bench | c++filt | grep -A20 'codegen_push_back'
+void codegen_push_back(ecs::vector<int>& arr, int x);
+
+__attribute__((noinline)) void codegen_push_back(ecs::vector<int>& arr, int x)
+{
+        arr.push_back(x);
+}
+
 ////////////////////////// Benchmarks
 #define BM_M_Container(C, test)         \
         while(state.KeepRunning())      \
@@ -293,6 +1060,491 @@ static void BM_CContAssignMore(benchmark::State& state)
         BM_M_Container(c_container, test_container_performance_assign_more);
 }
 
+// Short-lived containers: ecs::vector vs ecs::small_vector
+static void BM_EcsVectorShortLived(benchmark::State& state)
+{
+        test_container_allocations_short_lived<ecs::vector<ttype, counting_allocator<ttype>>>(
+                state);
+}
+static void BM_SmallVectorShortLived(benchmark::State& state)
+{
+        test_container_allocations_short_lived<
+                ecs::small_vector<ttype, 8, counting_allocator<ttype>>>(state);
+}
+
+// Mid-container insert and erase: std::vector vs ecs::vector
+static void BM_VectorMidInsertEraseInt(benchmark::State& state)
+{
+        test_container_performance_insert_erase_middle<std::vector<int>>(state);
+}
+static void BM_VectorMidInsertEraseUniquePtr(benchmark::State& state)
+{
+        test_container_performance_insert_erase_middle<std::vector<std::unique_ptr<int>>>(state);
+}
+static void BM_EcsVectorMidInsertEraseInt(benchmark::State& state)
+{
+        test_container_performance_insert_erase_middle<ecs::vector<int>>(state);
+}
+static void BM_EcsVectorMidInsertEraseUniquePtr(benchmark::State& state)
+{
+        test_container_performance_insert_erase_middle<ecs::vector<std::unique_ptr<int>>>(state);
+}
+
+// Worst-case emplace_back latency: ecs::vector vs ecs::stable_vector
+static void BM_EcsVectorEmplaceBackLatency(benchmark::State& state)
+{
+        test_container_latency_emplace_back<ecs::vector<int>>(state);
+}
+static void BM_StableVectorEmplaceBackLatency(benchmark::State& state)
+{
+        test_container_latency_emplace_back<ecs::stable_vector<int>>(state);
+}
+
+// Growth of large buffers from 1 MB: ecs::remap_vector vs ecs::vector
+static void BM_RemapVectorGrow(benchmark::State& state)
+{
+        test_container_performance_grow<ecs::remap_vector<unsigned char>>(state);
+}
+static void BM_EcsVectorGrow(benchmark::State& state)
+{
+        test_container_performance_grow<ecs::vector<unsigned char>>(state);
+}
+
+// push_back-heavy loops: std::vector vs ecs::vector
+static void BM_VectorPushBackInt(benchmark::State& state)
+{
+        test_container_performance_push_back<std::vector<int>>(state);
+}
+static void BM_VectorPushBackString(benchmark::State& state)
+{
+        test_container_performance_push_back<std::vector<std::string>>(state);
+}
+static void BM_EcsVectorPushBackInt(benchmark::State& state)
+{
+        test_container_performance_push_back<ecs::vector<int>>(state);
+}
+static void BM_EcsVectorPushBackString(benchmark::State& state)
+{
+        test_container_performance_push_back<ecs::vector<std::string>>(state);
+}
+
+// Reading a file into ecs::vector: value-initializing vs default-initializing resize
+static void BM_EcsVectorReadFileResize(benchmark::State& state)
+{
+        test_container_read_file(
+                state, [](ecs::vector<unsigned char>& arr, std::size_t n) { arr.resize(n); });
+}
+static void BM_EcsVectorReadFileResizeDefaultInit(benchmark::State& state)
+{
+        test_container_read_file(state, [](ecs::vector<unsigned char>& arr, std::size_t n) {
+                arr.resize_default_init(n);
+        });
+}
+
+// Copying trivially copyable elements: std::vector vs ecs::vector
+static void BM_VectorCopyInt(benchmark::State& state)
+{
+        test_container_performance_copy<std::vector<int>>(state);
+}
+static void BM_VectorCopyRecord64(benchmark::State& state)
+{
+        test_container_performance_copy<std::vector<record64>>(state);
+}
+static void BM_VectorAssignInt(benchmark::State& state)
+{
+        test_container_performance_assign<std::vector<int>>(state);
+}
+static void BM_VectorAssignRecord64(benchmark::State& state)
+{
+        test_container_performance_assign<std::vector<record64>>(state);
+}
+static void BM_EcsVectorCopyInt(benchmark::State& state)
+{
+        test_container_performance_copy<ecs::vector<int>>(state);
+}
+static void BM_EcsVectorCopyRecord64(benchmark::State& state)
+{
+        test_container_performance_copy<ecs::vector<record64>>(state);
+}
+static void BM_EcsVectorAssignInt(benchmark::State& state)
+{
+        test_container_performance_assign<ecs::vector<int>>(state);
+}
+static void BM_EcsVectorAssignRecord64(benchmark::State& state)
+{
+        test_container_performance_assign<ecs::vector<record64>>(state);
+}
+
+// Filling with copies of a value: broadcast stores vs elementwise construction
+template <typename T>
+using elementwise_vector = ecs::vector<T, elementwise_allocator<T>>;
+
+static void BM_EcsVectorFillAssignU16(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<std::uint16_t>>(state, fill_assign{});
+}
+static void BM_EcsVectorElementwiseFillAssignU16(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<std::uint16_t>>(state, fill_assign{});
+}
+static void BM_EcsVectorFillAssignU32(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<std::uint32_t>>(state, fill_assign{});
+}
+static void BM_EcsVectorElementwiseFillAssignU32(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<std::uint32_t>>(state, fill_assign{});
+}
+static void BM_EcsVectorFillAssignU64(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<std::uint64_t>>(state, fill_assign{});
+}
+static void BM_EcsVectorElementwiseFillAssignU64(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<std::uint64_t>>(state, fill_assign{});
+}
+static void BM_EcsVectorFillAssignRecord16(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<record16>>(state, fill_assign{});
+}
+static void BM_EcsVectorElementwiseFillAssignRecord16(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<record16>>(state, fill_assign{});
+}
+static void BM_EcsVectorFillInsertU16(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<std::uint16_t>>(state, fill_insert{});
+}
+static void BM_EcsVectorElementwiseFillInsertU16(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<std::uint16_t>>(state, fill_insert{});
+}
+static void BM_EcsVectorFillInsertU32(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<std::uint32_t>>(state, fill_insert{});
+}
+static void BM_EcsVectorElementwiseFillInsertU32(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<std::uint32_t>>(state, fill_insert{});
+}
+static void BM_EcsVectorFillInsertU64(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<std::uint64_t>>(state, fill_insert{});
+}
+static void BM_EcsVectorElementwiseFillInsertU64(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<std::uint64_t>>(state, fill_insert{});
+}
+static void BM_EcsVectorFillInsertRecord16(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<record16>>(state, fill_insert{});
+}
+static void BM_EcsVectorElementwiseFillInsertRecord16(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<record16>>(state, fill_insert{});
+}
+static void BM_EcsVectorFillResizeU16(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<std::uint16_t>>(state, fill_resize{});
+}
+static void BM_EcsVectorElementwiseFillResizeU16(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<std::uint16_t>>(state, fill_resize{});
+}
+static void BM_EcsVectorFillResizeU32(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<std::uint32_t>>(state, fill_resize{});
+}
+static void BM_EcsVectorElementwiseFillResizeU32(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<std::uint32_t>>(state, fill_resize{});
+}
+static void BM_EcsVectorFillResizeU64(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<std::uint64_t>>(state, fill_resize{});
+}
+static void BM_EcsVectorElementwiseFillResizeU64(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<std::uint64_t>>(state, fill_resize{});
+}
+static void BM_EcsVectorFillResizeRecord16(benchmark::State& state)
+{
+        test_container_performance_fill<ecs::vector<record16>>(state, fill_resize{});
+}
+static void BM_EcsVectorElementwiseFillResizeRecord16(benchmark::State& state)
+{
+        test_container_performance_fill<elementwise_vector<record16>>(state, fill_resize{});
+}
+
+// Comparison of equal containers: std::vector vs ecs::vector
+static void BM_VectorEqualU32(benchmark::State& state)
+{
+        test_container_performance_compare<std::vector<std::uint32_t>>(state, std::equal_to<>{});
+}
+static void BM_VectorLessU32(benchmark::State& state)
+{
+        test_container_performance_compare<std::vector<std::uint32_t>>(state, std::less<>{});
+}
+static void BM_VectorEqualU8(benchmark::State& state)
+{
+        test_container_performance_compare<std::vector<std::uint8_t>>(state, std::equal_to<>{});
+}
+static void BM_VectorLessU8(benchmark::State& state)
+{
+        test_container_performance_compare<std::vector<std::uint8_t>>(state, std::less<>{});
+}
+static void BM_EcsVectorEqualU32(benchmark::State& state)
+{
+        test_container_performance_compare<ecs::vector<std::uint32_t>>(state, std::equal_to<>{});
+}
+static void BM_EcsVectorLessU32(benchmark::State& state)
+{
+        test_container_performance_compare<ecs::vector<std::uint32_t>>(state, std::less<>{});
+}
+static void BM_EcsVectorEqualU8(benchmark::State& state)
+{
+        test_container_performance_compare<ecs::vector<std::uint8_t>>(state, std::equal_to<>{});
+}
+static void BM_EcsVectorLessU8(benchmark::State& state)
+{
+        test_container_performance_compare<ecs::vector<std::uint8_t>>(state, std::less<>{});
+}
+
+// Handing staged elements over: element loop vs cross-storage move assignment
+static void BM_HandoverLoop(benchmark::State& state)
+{
+        test_container_performance_handover<int>(state, [](auto& arr, auto& staging) {
+                arr.clear();
+                for(auto& x : staging)
+                        arr.push_back(std::move(x));
+
+                staging.clear();
+        });
+}
+static void BM_HandoverAssign(benchmark::State& state)
+{
+        test_container_performance_handover<int>(
+                state, [](auto& arr, auto& staging) { arr.assign(std::move(staging)); });
+}
+
+// Appending 1M elements: emplace_back loop vs batch append
+static void BM_EcsVectorAppendEmplaceBack(benchmark::State& state)
+{
+        test_container_performance_append<ecs::vector<int>>(state, [](auto& arr, auto& src) {
+                for(auto x : src)
+                        arr.emplace_back(x);
+        });
+}
+static void BM_EcsVectorAppendReserveUnchecked(benchmark::State& state)
+{
+        test_container_performance_append<ecs::vector<int>>(state, [](auto& arr, auto& src) {
+                arr.reserve(src.size());
+                for(auto x : src)
+                        arr.emplace_back_unchecked(x);
+        });
+}
+static void BM_EcsVectorAppendRange(benchmark::State& state)
+{
+        test_container_performance_append<ecs::vector<int>>(state, [](auto& arr, auto& src) {
+                arr.append(src.data(), src.data() + src.size());
+        });
+}
+static void BM_EcsVectorAppendN(benchmark::State& state)
+{
+        test_container_performance_append<ecs::vector<int>>(state, [](auto& arr, auto& src) {
+                arr.append_n(src.size(), [i = 0]() mutable { return i++; });
+        });
+}
+
+// Streamed insertion of 10K elements into 1M-element containers
+static void BM_VectorInsertStreamed(benchmark::State& state)
+{
+        test_container_performance_insert_streamed<std::vector<int>>(state);
+}
+static void BM_EcsVectorInsertStreamed(benchmark::State& state)
+{
+        test_container_performance_insert_streamed<ecs::vector<int>>(state);
+}
+
+// Erasure of 1K scattered elements from 100K-element containers
+static void BM_VectorEraseScatteredRepeated(benchmark::State& state)
+{
+        test_container_performance_erase_scattered<std::vector<int>>(state, repeated_erase{});
+}
+static void BM_VectorEraseScatteredRemoveIf(benchmark::State& state)
+{
+        test_container_performance_erase_scattered<std::vector<int>>(state, remove_if_erase{});
+}
+static void BM_EcsVectorEraseScatteredRepeated(benchmark::State& state)
+{
+        test_container_performance_erase_scattered<ecs::vector<int>>(state, repeated_erase{});
+}
+static void BM_EcsVectorEraseScatteredIf(benchmark::State& state)
+{
+        test_container_performance_erase_scattered<ecs::vector<int>>(state, predicate_erase{});
+}
+static void BM_EcsVectorEraseScatteredIndices(benchmark::State& state)
+{
+        test_container_performance_erase_scattered<ecs::vector<int>>(state, indexed_erase{});
+}
+static void BM_EcsVectorEraseScatteredUnordered(benchmark::State& state)
+{
+        test_container_performance_erase_scattered<ecs::vector<int>>(state, unordered_erase{});
+}
+
+// Shrinking of 64MB containers to 1% of their size
+static void BM_VectorShrinkToFit(benchmark::State& state)
+{
+        test_container_shrink_to_fit<std::vector<int>>(state);
+}
+static void BM_EcsVectorShrinkToFit(benchmark::State& state)
+{
+        test_container_shrink_to_fit<ecs::vector<int>>(state);
+}
+static void BM_EcsStableVectorShrinkToFit(benchmark::State& state)
+{
+        test_container_shrink_to_fit<ecs::stable_vector<int>>(state);
+}
+static void BM_EcsRemapVectorShrinkToFit(benchmark::State& state)
+{
+        test_container_shrink_to_fit<ecs::remap_vector<int>>(state);
+}
+
+// Iteration over an array of small containers (embedded storage with a full-width size, and
+// ecs::inplace_vector, which keeps its size in a single byte)
+static void BM_WideSizeStorageIterateSmall(benchmark::State& state)
+{
+        test_small_containers_iteration<
+                ecs::contiguous_container<literal_storage<std::uint8_t, 7>>>(state);
+}
+static void BM_EcsInplaceVectorIterateSmall(benchmark::State& state)
+{
+        test_small_containers_iteration<ecs::inplace_vector<std::uint8_t, 7>>(state);
+}
+
+// Latency distribution of emplace_back: ecs::vector, which grows from empty state, or reserves
+// memory up front, and ecs::fixed_vector, which allocates its capacity on construction
+static void BM_EcsVectorLatencyDistribution(benchmark::State& state)
+{
+        test_container_latency_distribution(state, [](std::size_t) { return ecs::vector<int>{}; });
+}
+static void BM_EcsVectorReservedLatencyDistribution(benchmark::State& state)
+{
+        test_container_latency_distribution(state, [](std::size_t n) {
+                ecs::vector<int> arr;
+                arr.reserve(n);
+                return arr;
+        });
+}
+static void BM_EcsFixedVectorLatencyDistribution(benchmark::State& state)
+{
+        test_container_latency_distribution(
+                state, [](std::size_t n) { return ecs::fixed_vector<int>(ecs::with_capacity, n); });
+}
+
+// Footprint and iteration speed of mostly empty vectors
+static void BM_EcsVectorIterateSparse(benchmark::State& state)
+{
+        test_sparse_containers_iteration<ecs::vector<int>>(state);
+}
+static void BM_EcsThinVectorIterateSparse(benchmark::State& state)
+{
+        test_sparse_containers_iteration<ecs::thin_vector<int>>(state);
+}
+
+// Building a container by insertion at the front: ecs::devector shifts no elements, while
+// ecs::vector moves all of them on each insertion
+static void BM_EcsVectorPrepend(benchmark::State& state)
+{
+        test_container_prepend<ecs::vector<int>>(
+                state, [](auto& arr, int x) { arr.insert(arr.begin(), x); });
+}
+static void BM_EcsDevectorPrepend(benchmark::State& state)
+{
+        test_container_prepend<ecs::devector<int>>(
+                state, [](auto& arr, int x) { arr.push_front(x); });
+}
+
+// Sliding window (FIFO queue) over contiguous storage
+static void BM_EcsVectorSlidingWindow(benchmark::State& state)
+{
+        test_container_sliding_window<ecs::vector<int>>(
+                state, [](auto& arr) { arr.erase(arr.begin()); });
+}
+static void BM_EcsDevectorSlidingWindow(benchmark::State& state)
+{
+        test_container_sliding_window<ecs::devector<int>>(
+                state, [](auto& arr) { arr.pop_front(); });
+}
+
+// Replaying an editing trace: ecs::vector shifts the tail on every edit, while ecs::gap_buffer
+// only moves its gap, when the cursor jumps
+static void BM_EcsVectorEditingTrace(benchmark::State& state)
+{
+        test_container_editing_trace<ecs::vector<char>>(state);
+}
+static void BM_EcsGapBufferEditingTrace(benchmark::State& state)
+{
+        test_container_editing_trace<ecs::gap_buffer<char>>(state);
+}
+
+#if __cpp_constexpr >= 201907L
+// Startup cost of a lookup table: the table is built before the first checksum of a 64-byte
+// message, or is embedded into the binary at compile time
+static void BM_EcsInplaceVectorTableRuntime(benchmark::State& state)
+{
+        unsigned char message[64] = {};
+        std::uint32_t crc = 0;
+
+        while(state.KeepRunning())
+        {
+                auto table = make_crc32_table();
+                opt_escape(table.data());
+                opt_escape(message);
+
+                crc = crc32(table, message, sizeof(message));
+                benchmark::DoNotOptimize(crc);
+        }
+}
+static void BM_EcsInplaceVectorTableConstexpr(benchmark::State& state)
+{
+        unsigned char message[64] = {};
+        std::uint32_t crc = 0;
+
+        while(state.KeepRunning())
+        {
+                opt_escape(message);
+                crc = crc32(crc32_table, message, sizeof(message));
+                benchmark::DoNotOptimize(crc);
+        }
+}
+#endif
+
+// Growth policies of ecs::vector
+template <typename GrowthPolicy>
+using policy_vector = ecs::vector<int, std::allocator<int>, GrowthPolicy>;
+
+static void BM_GrowthGeometric2(benchmark::State& state)
+{
+        test_container_growth_policy<policy_vector<ecs::geometric_growth<>>>(state);
+}
+static void BM_GrowthGeometric1_5(benchmark::State& state)
+{
+        test_container_growth_policy<policy_vector<ecs::geometric_growth<3, 2>>>(state);
+}
+static void BM_GrowthExact(benchmark::State& state)
+{
+        test_container_growth_policy<policy_vector<ecs::exact_growth>>(state);
+}
+static void BM_GrowthSizeClass(benchmark::State& state)
+{
+        test_container_growth_policy<policy_vector<ecs::size_class_growth<>>>(state);
+}
+static void BM_GrowthPage(benchmark::State& state)
+{
+        test_container_growth_policy<policy_vector<ecs::page_growth<>>>(state);
+}
+
 ////////////////
 BENCHMARK(BM_VectorBaseline);
 BENCHMARK(BM_VectorEmplaceBack);
@@ -324,4 +1576,111 @@ BENCHMARK(BM_CContInsertRangeInputIterAtEnd);
 BENCHMARK(BM_CContAssignLess);
 BENCHMARK(BM_CContAssignMore);
 
-BENCHMARK_MAIN()
+BENCHMARK(BM_EcsVectorShortLived)->RangeMultiplier(2)->Range(1, 32);
+BENCHMARK(BM_SmallVectorShortLived)->RangeMultiplier(2)->Range(1, 32);
+
+BENCHMARK(BM_VectorMidInsertEraseInt)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_VectorMidInsertEraseUniquePtr)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_EcsVectorMidInsertEraseInt)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_EcsVectorMidInsertEraseUniquePtr)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+BENCHMARK(BM_EcsVectorEmplaceBackLatency)->Arg(1 << 20)->Arg(1 << 24);
+BENCHMARK(BM_StableVectorEmplaceBackLatency)->Arg(1 << 20)->Arg(1 << 24);
+
+// remap_vector is registered first, since peak RSS of the process never decreases
+BENCHMARK(BM_RemapVectorGrow)
+        ->RangeMultiplier(16)
+        ->Range(std::int64_t{1} << 20, std::int64_t{1} << 32);
+BENCHMARK(BM_EcsVectorGrow)
+        ->RangeMultiplier(16)
+        ->Range(std::int64_t{1} << 20, std::int64_t{1} << 32);
+
+BENCHMARK(BM_GrowthGeometric2)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_GrowthGeometric1_5)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_GrowthExact)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_GrowthSizeClass)->Arg(1000)->Arg(100000);
+BENCHMARK(BM_GrowthPage)->Arg(1000)->Arg(100000);
+
+BENCHMARK(BM_VectorPushBackInt)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_VectorPushBackString)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_EcsVectorPushBackInt)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_EcsVectorPushBackString)->Arg(1 << 10)->Arg(1 << 20);
+BENCHMARK(BM_EcsVectorReadFileResize)->Arg(1 << 20)->Arg(1 << 28);
+BENCHMARK(BM_EcsVectorReadFileResizeDefaultInit)->Arg(1 << 20)->Arg(1 << 28);
+BENCHMARK(BM_VectorCopyInt)->Arg(1000000);
+BENCHMARK(BM_VectorCopyRecord64)->Arg(10000);
+BENCHMARK(BM_VectorAssignInt)->Arg(1000000);
+BENCHMARK(BM_VectorAssignRecord64)->Arg(10000);
+BENCHMARK(BM_EcsVectorCopyInt)->Arg(1000000);
+BENCHMARK(BM_EcsVectorCopyRecord64)->Arg(10000);
+BENCHMARK(BM_EcsVectorAssignInt)->Arg(1000000);
+BENCHMARK(BM_EcsVectorAssignRecord64)->Arg(10000);
+BENCHMARK(BM_EcsVectorFillAssignU16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillAssignU16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillAssignU32)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillAssignU32)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillAssignU64)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillAssignU64)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillAssignRecord16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillAssignRecord16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillInsertU16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillInsertU16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillInsertU32)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillInsertU32)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillInsertU64)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillInsertU64)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillInsertRecord16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillInsertRecord16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillResizeU16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillResizeU16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillResizeU32)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillResizeU32)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillResizeU64)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillResizeU64)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorFillResizeRecord16)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorElementwiseFillResizeRecord16)->Arg(1 << 16);
+BENCHMARK(BM_VectorEqualU32)->Arg(1 << 10)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK(BM_VectorLessU32)->Arg(1 << 10)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK(BM_VectorEqualU8)->Arg(1 << 10)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK(BM_VectorLessU8)->Arg(1 << 10)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK(BM_EcsVectorEqualU32)->Arg(1 << 10)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK(BM_EcsVectorLessU32)->Arg(1 << 10)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK(BM_EcsVectorEqualU8)->Arg(1 << 10)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK(BM_EcsVectorLessU8)->Arg(1 << 10)->Arg(1 << 20)->Arg(100 << 20);
+BENCHMARK(BM_HandoverLoop)->Arg(16)->Arg(1024);
+BENCHMARK(BM_HandoverAssign)->Arg(16)->Arg(1024);
+BENCHMARK(BM_EcsVectorAppendEmplaceBack)->Arg(1000000);
+BENCHMARK(BM_EcsVectorAppendReserveUnchecked)->Arg(1000000);
+BENCHMARK(BM_EcsVectorAppendRange)->Arg(1000000);
+BENCHMARK(BM_EcsVectorAppendN)->Arg(1000000);
+BENCHMARK(BM_VectorInsertStreamed)->Args({1000000, 10000});
+BENCHMARK(BM_EcsVectorInsertStreamed)->Args({1000000, 10000});
+BENCHMARK(BM_VectorEraseScatteredRepeated)->Args({100000, 1000});
+BENCHMARK(BM_VectorEraseScatteredRemoveIf)->Args({100000, 1000});
+BENCHMARK(BM_EcsVectorEraseScatteredRepeated)->Args({100000, 1000});
+BENCHMARK(BM_EcsVectorEraseScatteredIf)->Args({100000, 1000});
+BENCHMARK(BM_EcsVectorEraseScatteredIndices)->Args({100000, 1000});
+BENCHMARK(BM_EcsVectorEraseScatteredUnordered)->Args({100000, 1000});
+BENCHMARK(BM_VectorShrinkToFit)->Arg(1 << 24);
+BENCHMARK(BM_EcsVectorShrinkToFit)->Arg(1 << 24);
+BENCHMARK(BM_EcsStableVectorShrinkToFit)->Arg(1 << 24);
+BENCHMARK(BM_EcsRemapVectorShrinkToFit)->Arg(1 << 24);
+BENCHMARK(BM_WideSizeStorageIterateSmall)->Arg(1 << 22);
+BENCHMARK(BM_EcsInplaceVectorIterateSmall)->Arg(1 << 22);
+BENCHMARK(BM_EcsVectorLatencyDistribution)->Arg(1 << 20);
+BENCHMARK(BM_EcsVectorReservedLatencyDistribution)->Arg(1 << 20);
+BENCHMARK(BM_EcsFixedVectorLatencyDistribution)->Arg(1 << 20);
+BENCHMARK(BM_EcsVectorIterateSparse)->Arg(1 << 24);
+BENCHMARK(BM_EcsThinVectorIterateSparse)->Arg(1 << 24);
+BENCHMARK(BM_EcsVectorPrepend)->Arg(1 << 12);
+BENCHMARK(BM_EcsDevectorPrepend)->Arg(1 << 12);
+BENCHMARK(BM_EcsVectorSlidingWindow)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_EcsDevectorSlidingWindow)->Arg(1 << 10)->Arg(1 << 16);
+BENCHMARK(BM_EcsVectorEditingTrace)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_EcsGapBufferEditingTrace)->Arg(1 << 16)->Arg(1 << 20);
+#if __cpp_constexpr >= 201907L
+BENCHMARK(BM_EcsInplaceVectorTableRuntime);
+BENCHMARK(BM_EcsInplaceVectorTableConstexpr);
+#endif
+
+BENCHMARK_MAIN();
@@ -0,0 +1,7 @@
+// Copyright Ildus Nezametdinov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// benchmarks are built both with and without exceptions, e.g. code size can be compared with:
+// size benchmarks benchmarks_no_exceptions
+#include "../benchmarks.h"
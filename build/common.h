@@ -1,7 +1,7 @@
 #ifndef COMMON_H
 #define COMMON_H
 
-#include "../source/ecs/containers.h"
+#include "../source/ecs/contiguous_container.h"
 
 template <typename T, std::size_t N>
 struct literal_storage
@@ -124,13 +124,13 @@ struct dynamic_uninitialized_memory_buffer
                 auto ptr = std::make_unique<unsigned char[]>(capacity * sizeof(T));
                 auto first = reinterpret_cast<T *>(ptr.get()), last = first;
 
-                try
+                ECS_TRY
                 {
                         ecs::for_each_iter(begin(), begin() + size(), first, [&](auto i, auto j) {
                                 traits::construct(*this, j, std::move_if_noexcept(*i)), ++last;
                         });
                 }
-                catch(...)
+                ECS_CATCH(...)
                 {
                         ecs::for_each_iter(
                                 first, last, [this](auto i) { traits::destroy(*this, i); });
@@ -207,6 +207,45 @@ struct non_trivial
         int v{};
 };
 
+// allocator, which counts calls to allocate:
+std::size_t allocation_count{};
+
+template <typename T>
+struct counting_allocator
+{
+        using value_type = T;
+
+        counting_allocator() = default;
+
+        template <typename U>
+        counting_allocator(const counting_allocator<U>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+                ++allocation_count;
+                return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+                std::allocator<T>{}.deallocate(p, n);
+        }
+
+        template <typename U>
+        bool operator==(const counting_allocator<U>&) const noexcept
+        {
+                return true;
+        }
+
+        template <typename U>
+        bool operator!=(const counting_allocator<U>&) const noexcept
+        {
+                return false;
+        }
+};
+
 template <typename Iterator>
 struct input_iterator_adaptor
 {
@@ -13,34 +13,415 @@ namespace ecs
 namespace detail
 {
 template <typename Storage, typename... Args>
-void initialize_next(Storage& storage, Args&&... args)
+constexpr void initialize_next(Storage& storage, Args&&... args)
 {
         using traits = storage_traits<Storage>;
         traits::construct(storage, traits::end(storage), std::forward<Args>(args)...);
         traits::inc_size(storage);
 }
 
+// appends n elements copied from the given range (storage must have enough capacity):
+template <typename Storage, typename Size, typename ForwardIterator>
+constexpr void initialize_n(Storage& storage, Size n, ForwardIterator first)
+{
+        using traits = storage_traits<Storage>;
+        using size_type = typename traits::size_type;
+
+        traits::uninitialized_copy(storage, traits::end(storage), static_cast<size_type>(n), first);
+        traits::inc_size(storage, static_cast<size_type>(n));
+}
+
+// assigns n elements copied from the given range (failure to obtain memory is thrown, since
+// assignment operators can't report it through return values):
 template <typename Storage, typename Size, typename ForwardIterator>
 Storage& assign_n(Storage& storage, Size n, ForwardIterator first)
 {
         using traits = storage_traits<Storage>;
 
-        if(n > traits::capacity(storage))
-                traits::reallocate_assign(storage, n, first);
-        else
+        if(n <= traits::capacity(storage))
                 traits::assign(storage, n, first);
+        else if(!traits::reallocate_assign(storage, n, first))
+                throw_exception<std::bad_alloc>();
 
         return storage;
 }
 
 template <typename Storage>
-void destroy_elements(Storage& storage) noexcept
+constexpr void destroy_elements(Storage& storage) noexcept
 {
         using traits = storage_traits<Storage>;
         for_each_iter(traits::begin(storage), traits::end(storage),
                       [&storage](auto i) { traits::destroy(storage, i); });
 }
 
+// moves elements of the storage into new buffer, leaving a gap for n elements at the given
+// position (on exception all constructed elements are destroyed; on success, elements of the
+// storage are left in moved-from state, or relocated, in which case its size becomes 0):
+template <typename Storage, typename Pointer, typename Size,
+          std::enable_if_t<storage_traits<Storage>::is_trivially_relocatable, int> = 0>
+void relocate_around(Storage& storage, Pointer ptr, Pointer position, Size n) noexcept
+{
+        using traits = storage_traits<Storage>;
+        using difference_type = typename traits::difference_type;
+
+        auto gap = ptr + (position - traits::begin(storage));
+
+        traits::relocate(storage, traits::begin(storage), position, ptr);
+        traits::relocate(storage, position, traits::end(storage),
+                         gap + static_cast<difference_type>(n));
+        traits::set_size(storage, 0);
+}
+
+template <typename Storage, typename Pointer, typename Size,
+          std::enable_if_t<!storage_traits<Storage>::is_trivially_relocatable, int> = 0>
+void relocate_around(Storage& storage, Pointer ptr, Pointer position, Size n)
+{
+        using traits = storage_traits<Storage>;
+        using difference_type = typename traits::difference_type;
+
+        auto gap = ptr + (position - traits::begin(storage)), prefix_last = ptr;
+        auto suffix_first = gap + static_cast<difference_type>(n), suffix_last = suffix_first;
+
+        ECS_TRY
+        {
+                for(auto i = traits::begin(storage); i != position; ++i, (void)++prefix_last)
+                        traits::construct(storage, prefix_last, std::move_if_noexcept(*i));
+
+                for(auto i = position; i != traits::end(storage); ++i, (void)++suffix_last)
+                        traits::construct(storage, suffix_last, std::move_if_noexcept(*i));
+        }
+        ECS_CATCH(...)
+        {
+                auto destroy = [&storage](auto i) { traits::destroy(storage, i); };
+
+                for_each_iter(ptr, prefix_last, destroy);
+                for_each_iter(suffix_first, suffix_last, destroy);
+
+                ECS_RETHROW;
+        }
+}
+
+// initializes new buffer with elements of the storage and n new elements, which are inserted at
+// the given position (new elements are constructed first, since they might refer to existing
+// ones):
+template <typename Storage, typename Pointer, typename Size, typename ForwardIterator>
+void initialize_insert(Storage& storage, Pointer ptr, Pointer position, Size n,
+                       ForwardIterator first)
+{
+        using traits = storage_traits<Storage>;
+        using difference_type = typename traits::difference_type;
+
+        auto gap = ptr + (position - traits::begin(storage));
+        auto sentinel = gap + static_cast<difference_type>(n);
+
+        traits::uninitialized_copy(storage, gap, n, first);
+
+        ECS_TRY
+        {
+                relocate_around(storage, ptr, position, n);
+        }
+        ECS_CATCH(...)
+        {
+                for_each_iter(gap, sentinel, [&storage](auto i) { traits::destroy(storage, i); });
+                ECS_RETHROW;
+        }
+}
+
+// initializes new buffer with elements of the storage and a new element, which is constructed
+// at the end from the given arguments:
+template <typename Storage, typename Pointer, typename... Args>
+void initialize_emplace_back(Storage& storage, Pointer ptr, Args&&... args)
+{
+        using traits = storage_traits<Storage>;
+        using difference_type = typename traits::difference_type;
+
+        auto location = ptr + static_cast<difference_type>(traits::size(storage));
+        traits::construct(storage, location, std::forward<Args>(args)...);
+
+        ECS_TRY
+        {
+                relocate_around(storage, ptr, traits::end(storage), 0);
+        }
+        ECS_CATCH(...)
+        {
+                traits::destroy(storage, location);
+                ECS_RETHROW;
+        }
+}
+
+// allocator construct/destroy detection:
+template <typename Allocator, typename = void>
+struct allocator_has_construct : std::false_type
+{
+};
+
+template <typename Allocator>
+struct allocator_has_construct<
+        Allocator, std::void_t<decltype(std::declval<Allocator&>().construct(
+                           std::declval<typename Allocator::value_type*>()))>> : std::true_type
+{
+};
+
+template <typename Allocator, typename = void>
+struct allocator_has_destroy : std::false_type
+{
+};
+
+template <typename Allocator>
+struct allocator_has_destroy<
+        Allocator, std::void_t<decltype(std::declval<Allocator&>().destroy(
+                           std::declval<typename Allocator::value_type*>()))>> : std::true_type
+{
+};
+
+// elements can be relocated bytewise only if allocator does not customize their
+// construction and destruction:
+template <typename T, typename Allocator>
+using is_trivially_relocatable_with = std::integral_constant<
+        bool, is_trivially_relocatable<T>::value &&
+                      (std::is_same<Allocator, std::allocator<T>>::value ||
+                       (!allocator_has_construct<Allocator>::value &&
+                        !allocator_has_destroy<Allocator>::value))>;
+
+// default initialization of elements can be skipped only if allocator does not customize their
+// construction:
+template <typename T, typename Allocator>
+using is_trivially_default_constructible_with = std::integral_constant<
+        bool, std::is_trivially_default_constructible<T>::value &&
+                      (std::is_same<Allocator, std::allocator<T>>::value ||
+                       !allocator_has_construct<Allocator>::value)>;
+
+// allocates memory in constructors, which can't report failure through return values:
+template <typename Allocator, typename Size>
+auto allocate_or_throw(Allocator& a, Size n)
+{
+        auto ptr = std::allocator_traits<Allocator>::allocate(a, n);
+        if(!ptr && n != 0)
+                throw_exception<std::bad_alloc>();
+
+        return ptr;
+}
+
+// error policy of storages, which obtain memory from the allocator (allocator can select it,
+// e.g. if it returns null pointer, when it fails to allocate memory):
+template <typename Allocator, typename = void>
+struct allocator_error_policy
+{
+        using type = default_error_policy;
+};
+
+template <typename Allocator>
+struct allocator_error_policy<Allocator, std::void_t<typename Allocator::error_policy>>
+{
+        using type = typename Allocator::error_policy;
+};
+
+// buffer, which is obtained from the allocator (elements are kept at the given offset in it):
+template <typename Allocator>
+struct allocated_buffer
+{
+        // types:
+        using alloc_traits = std::allocator_traits<Allocator>;
+
+        using pointer = typename alloc_traits::pointer;
+        using size_type = typename alloc_traits::size_type;
+        using difference_type = typename alloc_traits::difference_type;
+
+        // allocates buffer of the given capacity (pointer is null on failure):
+        static allocated_buffer allocate(Allocator& a, size_type capacity)
+        {
+                return {alloc_traits::allocate(a, capacity), capacity, 0};
+        }
+
+        void deallocate(Allocator& a) const noexcept
+        {
+                alloc_traits::deallocate(a, ptr, capacity);
+        }
+
+        //
+        pointer elements() const noexcept
+        {
+                return ptr + offset;
+        }
+
+        //
+        pointer ptr;
+        size_type capacity;
+        difference_type offset;
+};
+
+// reallocation of storages, which obtain memory from the allocator: storage describes its buffer
+// with buffer_ type (see allocated_buffer), and implements replace_buffer_(buffer, n), which
+// deallocates current buffer and takes the given one with n elements:
+template <typename Storage>
+struct storage_reallocation
+{
+        // types:
+        using traits = storage_traits<Storage>;
+        using buffer = typename Storage::buffer_;
+
+        using pointer = typename traits::pointer;
+        using size_type = typename traits::size_type;
+
+        // reports failure to obtain memory: throws exception, or returns false, if errors are
+        // reported through return values:
+        template <typename Exception, typename... Args>
+        static bool fail(Args&&... args)
+        {
+                if /*constexpr*/ (!traits::reports_errors)
+                        throw_exception<Exception>(std::forward<Args>(args)...);
+
+                return false;
+        }
+
+        // computes capacity of new buffer for sz elements (returns 0 on failure):
+        static size_type next_capacity(const Storage& storage, size_type sz)
+        {
+                if(sz > traits::max_size(storage))
+                        return (void)fail<std::length_error>(""), size_type{};
+
+                return traits::next_capacity(storage, sz);
+        }
+
+        // allocates new buffer (its pointer is null on failure, or if capacity is 0):
+        static buffer allocate(Storage& storage, size_type capacity)
+        {
+                auto b = (capacity != 0) ? buffer::allocate(storage.get_allocator_ref(), capacity)
+                                         : buffer{};
+                if(!b.ptr)
+                        (void)fail<std::bad_alloc>();
+
+                return b;
+        }
+
+        // initializes elements in the given buffer with the given function, then destroys
+        // current elements, and makes the storage use the buffer, which holds n elements (the
+        // buffer is deallocated, if initialization throws):
+        template <typename Initializer>
+        static bool replace(Storage& storage, buffer b, size_type n, Initializer init)
+        {
+                if(!b.ptr)
+                        return false;
+
+                ECS_TRY
+                {
+                        init(b.elements());
+                }
+                ECS_CATCH(...)
+                {
+                        b.deallocate(storage.get_allocator_ref());
+                        ECS_RETHROW;
+                }
+
+                destroy_elements(storage);
+                storage.replace_buffer_(b, n);
+
+                return true;
+        }
+
+        // (n elements are initialized one by one, and the ones, which are initialized before
+        // exception is thrown, are destroyed)
+        template <typename Initializer>
+        static bool replace_n(Storage& storage, buffer b, size_type n, Initializer init)
+        {
+                return replace(storage, b, n, [&storage, n, &init](pointer first) {
+                        auto last = first;
+
+                        ECS_TRY
+                        {
+                                for(auto i = n; i != 0; --i, (void)++last)
+                                        init(last);
+                        }
+                        ECS_CATCH(...)
+                        {
+                                for_each_iter(first, last, [&storage](auto i) {
+                                        traits::destroy(storage, i);
+                                });
+
+                                ECS_RETHROW;
+                        }
+                });
+        }
+
+        // moves elements of the storage into the given buffer:
+        template <bool E = traits::is_trivially_relocatable, std::enable_if_t<E, int> = 0>
+        static bool move(Storage& storage, buffer b)
+        {
+                if(!b.ptr)
+                        return false;
+
+                auto n = traits::size(storage);
+                traits::relocate(storage, traits::begin(storage), traits::end(storage),
+                                 b.elements());
+
+                storage.replace_buffer_(b, n);
+                return true;
+        }
+
+        template <bool E = traits::is_trivially_relocatable, std::enable_if_t<!E, int> = 0>
+        static bool move(Storage& storage, buffer b)
+        {
+                auto first = traits::begin(storage);
+                return replace_n(storage, b, traits::size(storage), [&storage, &first](auto i) {
+                        traits::construct(storage, i, std::move_if_noexcept(*first)), (void)++first;
+                });
+        }
+
+        // moves elements of the storage into new buffer of the given capacity:
+        static bool reallocate(Storage& storage, size_type capacity)
+        {
+                return move(storage, allocate(storage, capacity));
+        }
+
+        // reallocates storage, so it holds n elements copied from the given range:
+        template <typename ForwardIterator>
+        static bool assign(Storage& storage, size_type n, ForwardIterator first)
+        {
+                return replace(storage, allocate(storage, next_capacity(storage, n)), n,
+                               [&storage, n, &first](pointer ptr) {
+                                       traits::uninitialized_copy(storage, ptr, n, first);
+                               });
+        }
+
+        // reallocates storage, so it holds n more elements, which are initialized along with
+        // existing ones by the given function:
+        template <typename Initializer>
+        static bool grow(Storage& storage, size_type n, Initializer init)
+        {
+                if(n > traits::max_size(storage) - traits::size(storage))
+                        return fail<std::length_error>("");
+
+                auto sz = traits::size(storage) + n;
+                return replace(storage, allocate(storage, next_capacity(storage, sz)), sz, init);
+        }
+
+        // moves elements of other storage into new buffer of exactly their number (used in
+        // constructors, which can't report failure through return values, so it is thrown):
+        static void take_elements(Storage& storage, Storage& other)
+        {
+                auto n = traits::size(other);
+                auto first = traits::begin(other);
+                auto b = buffer::allocate(storage.get_allocator_ref(), n);
+
+                if(!b.ptr)
+                        throw_exception<std::bad_alloc>();
+
+                replace_n(storage, b, n, [&storage, &first](auto i) {
+                        traits::construct(storage, i, std::move(*first)), (void)++first;
+                });
+        }
+};
+
+// the smallest unsigned type, which can represent the given number (sizes of embedded storages
+// are kept in it, so that they don't add padding to small containers):
+template <std::size_t N>
+using compact_size_t = std::conditional_t<
+        (N <= std::numeric_limits<std::uint8_t>::max()), std::uint8_t,
+        std::conditional_t<
+                (N <= std::numeric_limits<std::uint16_t>::max()), std::uint16_t,
+                std::conditional_t<(N <= std::numeric_limits<std::uint32_t>::max()),
+                                   std::uint32_t, std::size_t>>>;
+
 //
 } // namespace detail
 
@@ -50,44 +431,61 @@ struct inplace_storage
         // types:
         using traits = storage_traits<inplace_storage>;
         using value_type = T;
+        using error_policy = returning_errors;
 
         // friend declaration:
         friend struct storage_traits<inplace_storage>;
 
+private:
+        // elements of trivial types are stored in an array of objects, which are created by
+        // assignment (element-wise operations are then allowed in constant expressions):
+        static constexpr bool is_literal_ = detail::is_constant_storable<value_type>;
+
+        static constexpr bool is_trivially_relocatable =
+                is_literal_ || ecs::is_trivially_relocatable<value_type>::value;
+        static constexpr bool is_trivially_default_constructible =
+                std::is_trivially_default_constructible<value_type>::value;
+
+public:
         // construct:
-        inplace_storage() = default;
+        ECS_CONSTEXPR20 inplace_storage() noexcept
+        {
+                // constant expressions can't contain uninitialized objects
+                if(detail::is_constant_evaluated())
+                        detail::fill_elements(begin(), N, value_type{});
+        }
 
-        explicit inplace_storage(std::size_t n) : inplace_storage{}
+        constexpr explicit inplace_storage(std::size_t n) : inplace_storage{}
         {
                 for(n = std::min(n, capacity()); n > 0; --n)
                         detail::initialize_next(*this);
         }
 
-        inplace_storage(std::size_t n, const value_type& x) : inplace_storage{}
+        constexpr inplace_storage(std::size_t n, const value_type& x) : inplace_storage{}
         {
                 for(n = std::min(n, capacity()); n > 0; --n)
                         detail::initialize_next(*this, x);
         }
 
         template <typename InputIterator, typename = check_input_iterator<InputIterator>>
-        inplace_storage(InputIterator first, InputIterator last) : inplace_storage{}
+        constexpr inplace_storage(InputIterator first, InputIterator last) : inplace_storage{}
         {
                 for(; first != last && !traits::full(*this); ++first)
                         detail::initialize_next(*this, *first);
         }
 
-        inplace_storage(std::initializer_list<value_type> il)
+        constexpr inplace_storage(std::initializer_list<value_type> il)
                 : inplace_storage{il.begin(), il.end()}
         {
         }
 
         // copy/move construct:
-        inplace_storage(const inplace_storage& other) : inplace_storage{}
+        constexpr inplace_storage(const inplace_storage& other) : inplace_storage{}
         {
                 traits::assign(*this, traits::size(other), traits::begin(other));
         }
 
-        inplace_storage(inplace_storage&& other) : inplace_storage{}
+        constexpr inplace_storage(inplace_storage&& other) : inplace_storage{}
         {
                 traits::assign(
                         *this, traits::size(other), std::make_move_iterator(traits::begin(other)));
@@ -97,7 +495,7 @@ struct inplace_storage
         }
 
         // copy/move assign:
-        inplace_storage& operator=(const inplace_storage& other)
+        constexpr inplace_storage& operator=(const inplace_storage& other)
         {
                 if(this == std::addressof(other))
                         return *this;
@@ -106,7 +504,7 @@ struct inplace_storage
                 return *this;
         }
 
-        inplace_storage& operator=(inplace_storage&& other)
+        constexpr inplace_storage& operator=(inplace_storage&& other)
         {
                 if(this == std::addressof(other))
                         return *this;
@@ -121,15 +519,15 @@ struct inplace_storage
         }
 
         // swap:
-        void swap(inplace_storage& other)
+        constexpr void swap(inplace_storage& other)
         {
                 auto& x = size() >= other.size() ? other : *this;
                 auto& y = size() >= other.size() ? *this : other;
 
                 auto n = x.size();
-                auto f = y.begin() + n, l = y.end();
+                auto f = traits::begin(y) + n, l = traits::end(y);
 
-                std::swap_ranges(x.begin(), x.end(), y.begin());
+                std::swap_ranges(traits::begin(x), traits::end(x), traits::begin(y));
 
                 for_each_iter(f, l, [&x](auto i) { detail::initialize_next(x, std::move(*i)); });
                 for_each_iter(f, l, [&y](auto i) { traits::destroy(y, i); });
@@ -138,219 +536,1643 @@ struct inplace_storage
         }
 
 protected:
-        ~inplace_storage()
+        ECS_CONSTEXPR20 ~inplace_storage()
         {
                 if /*constexpr*/ (!std::is_trivially_destructible<value_type>::value)
                         detail::destroy_elements(*this);
         }
 
 private:
+        // objects of trivial types are assigned, so that they can be created at compile time:
+        template <bool E = is_literal_, std::enable_if_t<E, int> = 0, typename... Args>
+        constexpr void construct(value_type* location, Args&&... args)
+        {
+                *location = value_type{std::forward<Args>(args)...};
+        }
+
+        template <bool E = is_literal_, std::enable_if_t<E, int> = 0>
+        constexpr value_type* begin() noexcept
+        {
+                return data_;
+        }
+
+        template <bool E = is_literal_, std::enable_if_t<E, int> = 0>
+        constexpr const value_type* begin() const noexcept
+        {
+                return data_;
+        }
+
+        template <bool E = is_literal_, std::enable_if_t<!E, int> = 0>
         value_type* begin() noexcept
         {
                 return reinterpret_cast<value_type*>(data_);
         }
 
+        template <bool E = is_literal_, std::enable_if_t<!E, int> = 0>
         const value_type* begin() const noexcept
         {
                 return reinterpret_cast<const value_type*>(data_);
         }
 
-        void set_size(std::size_t n) noexcept
+        constexpr void set_size(std::size_t n) noexcept
         {
-                size_ = n;
+                size_ = static_cast<detail::compact_size_t<N>>(n);
         }
 
-        std::size_t size() const noexcept
+        constexpr std::size_t size() const noexcept
         {
                 return size_;
         }
 
-        std::size_t capacity() const noexcept
+        constexpr std::size_t capacity() const noexcept
         {
                 return N;
         }
 
 private:
-        alignas(value_type) unsigned char data_[N * sizeof(value_type)];
-        std::size_t size_{};
+        using buffer = std::conditional_t<is_literal_, value_type[N],
+                                          unsigned char[N * sizeof(value_type)]>;
+
+        alignas(value_type) buffer data_;
+        detail::compact_size_t<N> size_{};
 };
 
-template <typename Storage>
-struct allocator_aware_storage : Storage
+// tag, which selects construction of an empty container with the given capacity (unlike
+// construction from a size, which creates elements):
+struct with_capacity_t
 {
-        // types:
-        using typename Storage::value_type;
-        using typename Storage::allocator_type;
+        explicit with_capacity_t() = default;
+};
 
-        using pointer = typename std::allocator_traits<allocator_type>::pointer;
-        using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+inline constexpr with_capacity_t with_capacity{};
 
-        using size_type = typename std::allocator_traits<allocator_type>::size_type;
-        using difference_type = typename std::allocator_traits<allocator_type>::difference_type;
+// storage, which allocates its capacity once on construction (it never reallocates, and
+// reports overflow through return values, like inplace_storage):
+template <typename T, typename Allocator = std::allocator<T>>
+struct fixed_storage
+{
+        // types:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using error_policy = returning_errors;
 
         // friend declaration:
-        friend struct storage_traits<allocator_aware_storage>;
+        friend struct storage_traits<fixed_storage>;
+
+private: //
+        // additional types:
+        using traits_ = storage_traits<fixed_storage>;
+        using alloc_traits_ = std::allocator_traits<allocator_type>;
 
+        using pointer_ = typename alloc_traits_::pointer;
+        using const_pointer_ = typename alloc_traits_::const_pointer;
+
+        using size_type_ = typename alloc_traits_::size_type;
+        using difference_type_ = typename alloc_traits_::difference_type;
+
+        // elements are relocated bytewise, if allocator permits:
+        static constexpr bool is_trivially_relocatable =
+                detail::is_trivially_relocatable_with<T, Allocator>::value;
+
+        // elements are left uninitialized on default initialization, if allocator permits:
+        static constexpr bool is_trivially_default_constructible =
+                detail::is_trivially_default_constructible_with<T, Allocator>::value;
+
+        struct implementation_ : allocator_type
+        {
+                implementation_() noexcept(noexcept(allocator_type{})) : allocator_type{}
+                {
+                }
+
+                implementation_(const allocator_type& a) noexcept : allocator_type{a}
+                {
+                }
+
+                implementation_(const implementation_&) = delete;
+                implementation_(implementation_&&) = default;
+
+                implementation_& operator=(const implementation_&) = delete;
+                implementation_& operator=(implementation_&&) = default;
+
+                //
+                void swap(implementation_& other) noexcept
+                {
+                        std::swap(beg_, other.beg_);
+                        std::swap(end_, other.end_);
+                        std::swap(cap_, other.cap_);
+                }
+
+                //
+                pointer_ beg_{}, end_{}, cap_{};
+        };
+
+public:
         // construct:
-        allocator_aware_storage() noexcept(noexcept(allocator_type{})) : Storage{}
+        fixed_storage() noexcept(noexcept(implementation_{})) : impl_{}
         {
         }
 
-        explicit allocator_aware_storage(const allocator_type& a) noexcept : Storage{a}
+        explicit fixed_storage(const allocator_type& a) noexcept : impl_{a}
         {
         }
 
-        explicit allocator_aware_storage(size_type n, const allocator_type& a = allocator_type{})
-                : allocator_aware_storage{n, a, principal_tag_{}}
+        fixed_storage(with_capacity_t, std::size_t capacity,
+                      const allocator_type& a = allocator_type{})
+                : impl_{a}
+        {
+                allocate_(capacity);
+        }
+
+        // (capacity equals the number of created elements)
+        explicit fixed_storage(std::size_t n, const allocator_type& a = allocator_type{})
+                : fixed_storage{with_capacity, n, a}
         {
                 for(; n > 0; --n)
                         detail::initialize_next(*this);
         }
 
-        allocator_aware_storage(size_type n, const value_type& x,
-                                const allocator_type& a = allocator_type{})
-                : allocator_aware_storage{n, a, principal_tag_{}}
+        fixed_storage(std::size_t n, const value_type& x,
+                      const allocator_type& a = allocator_type{})
+                : fixed_storage{with_capacity, n, a}
+        {
+                for(; n > 0; --n)
+                        detail::initialize_next(*this, x);
+        }
+
+        // copy/move construct (copy has the same capacity):
+        fixed_storage(const fixed_storage& other)
+                : fixed_storage{with_capacity, other.capacity(),
+                                alloc_traits_::select_on_container_copy_construction(
+                                        other.get_allocator_ref())}
+        {
+                detail::initialize_n(*this, other.size(), other.begin());
+        }
+
+        fixed_storage(fixed_storage&& other) noexcept : impl_{std::move(other.impl_)}
+        {
+                other.impl_.beg_ = other.impl_.end_ = other.impl_.cap_ = pointer_{};
+        }
+
+        // copy/move assign (elements are assigned within current capacity, which is only taken
+        // from the other storage, when its buffer is moved):
+        fixed_storage& operator=(const fixed_storage& other)
+        {
+                if(this == std::addressof(other))
+                        return *this;
+
+                // copy allocator if needed
+                if /*constexpr*/ (alloc_traits_::propagate_on_container_copy_assignment::value)
+                {
+                        // reallocate memory with the new allocator if allocators are not equal
+                        if(!alloc_traits_::is_always_equal::value &&
+                           get_allocator_ref() != other.get_allocator_ref())
+                        {
+                                auto n = capacity();
+
+                                detail::destroy_elements(*this);
+                                deallocate_();
+
+                                get_allocator_ref() = other.get_allocator_ref();
+                                allocate_(n);
+                        }
+                        else
+                                get_allocator_ref() = other.get_allocator_ref();
+                }
+
+                return detail::assign_n(*this, other.size(), other.begin());
+        }
+
+        fixed_storage& operator=(fixed_storage&& other) noexcept(
+                alloc_traits_::propagate_on_container_move_assignment::value ||
+                alloc_traits_::is_always_equal::value)
+        {
+                if(this == std::addressof(other))
+                        return *this;
+
+                if(alloc_traits_::propagate_on_container_move_assignment::value ||
+                   alloc_traits_::is_always_equal::value ||
+                   get_allocator_ref() == other.get_allocator_ref())
+                {
+                        detail::destroy_elements(*this);
+                        deallocate_();
+
+                        impl_.swap(other.impl_);
+
+                        if /*constexpr*/ (
+                                alloc_traits_::propagate_on_container_move_assignment::value)
+                                get_allocator_ref() = std::move(other.get_allocator_ref());
+
+                        return *this;
+                }
+
+                detail::assign_n(*this, other.size(), std::make_move_iterator(other.begin()));
+
+                detail::destroy_elements(other);
+                other.set_size(0);
+
+                return *this;
+        }
+
+        // swap:
+        void swap(fixed_storage& other) noexcept(
+                alloc_traits_::propagate_on_container_swap::value ||
+                alloc_traits_::is_always_equal::value)
+        {
+                impl_.swap(other.impl_);
+                if(alloc_traits_::propagate_on_container_swap::value)
+                        std::swap(get_allocator_ref(), other.get_allocator_ref());
+        }
+
+        // returns copy of current allocator:
+        allocator_type get_allocator() const noexcept
+        {
+                return get_allocator_ref();
+        }
+
+protected:
+        ~fixed_storage()
+        {
+                detail::destroy_elements(*this);
+                deallocate_();
+        }
+
+private:
+        allocator_type& get_allocator_ref() noexcept
+        {
+                return static_cast<allocator_type&>(impl_);
+        }
+
+        const allocator_type& get_allocator_ref() const noexcept
+        {
+                return static_cast<const allocator_type&>(impl_);
+        }
+
+        //
+        template <typename... Args>
+        void construct(pointer_ location, Args&&... args)
+        {
+                alloc_traits_::construct(
+                        impl_, traits_::ptr_cast(location), std::forward<Args>(args)...);
+        }
+
+        void destroy(pointer_ location) noexcept
+        {
+                alloc_traits_::destroy(impl_, traits_::ptr_cast(location));
+        }
+
+        //
+        pointer_ begin() noexcept
+        {
+                return impl_.beg_;
+        }
+
+        const_pointer_ begin() const noexcept
+        {
+                return impl_.beg_;
+        }
+
+        //
+        pointer_ end() noexcept
+        {
+                return impl_.end_;
+        }
+
+        const_pointer_ end() const noexcept
+        {
+                return impl_.end_;
+        }
+
+        //
+        bool empty() const noexcept
+        {
+                return impl_.beg_ == impl_.end_;
+        }
+
+        bool full() const noexcept
+        {
+                return impl_.end_ == impl_.cap_;
+        }
+
+        //
+        void set_size(size_type_ n) noexcept
+        {
+                impl_.end_ = impl_.beg_ + static_cast<difference_type_>(n);
+        }
+
+        void inc_size(size_type_ n) noexcept
+        {
+                impl_.end_ += static_cast<difference_type_>(n);
+        }
+
+        void dec_size(size_type_ n) noexcept
+        {
+                impl_.end_ -= static_cast<difference_type_>(n);
+        }
+
+        //
+        size_type_ size() const noexcept
+        {
+                return static_cast<size_type_>(impl_.end_ - impl_.beg_);
+        }
+
+        size_type_ capacity() const noexcept
+        {
+                return static_cast<size_type_>(impl_.cap_ - impl_.beg_);
+        }
+
+        // allocates buffer of the given capacity (storage must not have a buffer):
+        void allocate_(size_type_ capacity)
+        {
+                if(capacity == 0)
+                        return;
+
+                impl_.beg_ = impl_.end_ = impl_.cap_ = detail::allocate_or_throw(impl_, capacity);
+                impl_.cap_ += static_cast<difference_type_>(capacity);
+        }
+
+        void deallocate_() noexcept
+        {
+                if(impl_.beg_)
+                        alloc_traits_::deallocate(impl_, impl_.beg_, capacity());
+
+                impl_.beg_ = impl_.end_ = impl_.cap_ = pointer_{};
+        }
+
+        //
+        implementation_ impl_;
+};
+
+template <typename Storage>
+struct allocator_aware_storage : Storage
+{
+        // types:
+        using typename Storage::value_type;
+        using typename Storage::allocator_type;
+
+        using pointer = typename std::allocator_traits<allocator_type>::pointer;
+        using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+
+        using size_type = typename std::allocator_traits<allocator_type>::size_type;
+        using difference_type = typename std::allocator_traits<allocator_type>::difference_type;
+
+        // friend declaration:
+        friend struct storage_traits<allocator_aware_storage>;
+
+        // construct:
+        allocator_aware_storage() noexcept(noexcept(allocator_type{})) : Storage{}
+        {
+        }
+
+        explicit allocator_aware_storage(const allocator_type& a) noexcept : Storage{a}
+        {
+        }
+
+        explicit allocator_aware_storage(size_type n, const allocator_type& a = allocator_type{})
+                : allocator_aware_storage{n, a, principal_tag_{}}
+        {
+                for(; n > 0; --n)
+                        detail::initialize_next(*this);
+        }
+
+        allocator_aware_storage(size_type n, const value_type& x,
+                                const allocator_type& a = allocator_type{})
+                : allocator_aware_storage{n, a, principal_tag_{}}
+        {
+                for(; n > 0; --n)
+                        detail::initialize_next(*this, x);
+        }
+
+        template <typename InputIterator, typename = check_input_iterator<InputIterator>>
+        allocator_aware_storage(InputIterator first, InputIterator last,
+                                const allocator_type& a = allocator_type{})
+                : allocator_aware_storage{
+                          first, last, a,
+                          typename std::iterator_traits<InputIterator>::iterator_category{}}
+        {
+        }
+
+        allocator_aware_storage(std::initializer_list<value_type> il,
+                                const allocator_type& a = allocator_type{})
+                : allocator_aware_storage{il.begin(), il.end(), a, std::forward_iterator_tag{}}
+        {
+        }
+
+        // copy/move construct:
+        allocator_aware_storage(const allocator_aware_storage& other)
+                : allocator_aware_storage{
+                          other, alloc_traits_::select_on_container_copy_construction(
+                                         other.get_allocator_ref())}
+        {
+        }
+
+        allocator_aware_storage(allocator_aware_storage&&) = default;
+
+        //
+        allocator_aware_storage(const allocator_aware_storage& other, const allocator_type& a)
+                : allocator_aware_storage{traits_::size(other), a, principal_tag_{}}
+        {
+                detail::initialize_n(*this, traits_::size(other), traits_::begin(other));
+        }
+
+        allocator_aware_storage(allocator_aware_storage&& other, const allocator_type& a)
+                : Storage{std::move(other), a}
+        {
+                detail::destroy_elements(other);
+                traits_::set_size(other, 0);
+        }
+
+        // copy/move assign:
+        allocator_aware_storage& operator=(const allocator_aware_storage& other)
+        {
+                if(this == std::addressof(other))
+                        return *this;
+
+                // copy allocator if needed
+                if /*constexpr*/ (alloc_traits_::propagate_on_container_copy_assignment::value)
+                {
+                        // deallocate memory if allocators are not equal
+                        if(!alloc_traits_::is_always_equal::value &&
+                           this->get_allocator_ref() != other.get_allocator_ref())
+                        {
+                                detail::destroy_elements(*this);
+                                this->deallocate();
+                        }
+
+                        this->get_allocator_ref() = other.get_allocator_ref();
+                }
+
+                return detail::assign_n(*this, traits_::size(other), traits_::begin(other));
+        }
+
+        allocator_aware_storage& operator=(allocator_aware_storage&&) = default;
+
+        // returns copy of current allocator:
+        allocator_type get_allocator() const noexcept
+        {
+                return this->get_allocator_ref();
+        }
+
+protected:
+        ~allocator_aware_storage()
+        {
+                detail::destroy_elements(*this);
+        }
+
+private: //
+        // additional types:
+        struct principal_tag_
+        {
+        };
+
+        using traits_ = storage_traits<allocator_aware_storage>;
+        using alloc_traits_ = std::allocator_traits<allocator_type>;
+
+        // requirement on allocator type:
+        static_assert(std::is_same<value_type, typename alloc_traits_::value_type>::value);
+
+        // additional constructors:
+        allocator_aware_storage(size_type n, const allocator_type& a, principal_tag_)
+                : Storage{n, a}
+        {
+        }
+
+        template <typename InputIterator>
+        allocator_aware_storage(InputIterator first, InputIterator last, const allocator_type& a,
+                                std::input_iterator_tag)
+                : allocator_aware_storage{a}
+        {
+                for(; first != last; ++first)
+                {
+                        if(traits_::full(*this) &&
+                           !traits_::reallocate(*this, traits_::capacity(*this) + 1))
+                                detail::throw_exception<std::bad_alloc>();
+
+                        detail::initialize_next(*this, *first);
+                }
+        }
+
+        template <typename ForwardIterator>
+        allocator_aware_storage(ForwardIterator first, ForwardIterator last,
+                                const allocator_type& a, std::forward_iterator_tag)
+                : allocator_aware_storage{
+                          static_cast<size_type>(std::distance(first, last)), a, principal_tag_{}}
+        {
+                detail::initialize_n(*this, std::distance(first, last), first);
+        }
+};
+
+template <typename T, typename Allocator, typename GrowthPolicy = geometric_growth<>>
+struct vector_storage
+{
+        // types:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using growth_policy = GrowthPolicy;
+        using error_policy = typename detail::allocator_error_policy<Allocator>::type;
+
+        // friend declarations:
+        friend struct storage_traits<vector_storage>;
+        friend struct detail::storage_reallocation<vector_storage>;
+
+        template <typename, typename, typename>
+        friend struct vector_storage;
+
+        // deleted copy constructor and copy assignment operator:
+        vector_storage(const vector_storage&) = delete;
+        vector_storage& operator=(const vector_storage&) = delete;
+
+protected: //
+        // additional types:
+        using traits_ = storage_traits<vector_storage>;
+        using alloc_traits_ = std::allocator_traits<allocator_type>;
+
+        using pointer_ = typename alloc_traits_::pointer;
+        using const_pointer_ = typename alloc_traits_::const_pointer;
+
+        using size_type_ = typename alloc_traits_::size_type;
+        using difference_type_ = typename alloc_traits_::difference_type;
+
+        using buffer_ = detail::allocated_buffer<allocator_type>;
+        using reallocation_ = detail::storage_reallocation<vector_storage>;
+
+        // elements are relocated bytewise, if allocator permits:
+        static constexpr bool is_trivially_relocatable =
+                detail::is_trivially_relocatable_with<T, Allocator>::value;
+
+        // elements are left uninitialized on default initialization, if allocator permits:
+        static constexpr bool is_trivially_default_constructible =
+                detail::is_trivially_default_constructible_with<T, Allocator>::value;
+
+        struct implementation_ : allocator_type
+        {
+                implementation_() noexcept(noexcept(allocator_type{})) : allocator_type{}
+                {
+                }
+
+                implementation_(const allocator_type& a) noexcept : allocator_type{a}
+                {
+                }
+
+                implementation_(const implementation_&) = delete;
+                implementation_(implementation_&&) = default;
+
+                implementation_& operator=(const implementation_&) = delete;
+                implementation_& operator=(implementation_&&) = default;
+
+                //
+                void swap(implementation_& other) noexcept
+                {
+                        std::swap(beg_, other.beg_);
+                        std::swap(end_, other.end_);
+                        std::swap(cap_, other.cap_);
+                }
+
+                //
+                pointer_ beg_{}, end_{}, cap_{};
+        };
+
+        // construct/destroy:
+        vector_storage() noexcept(noexcept(implementation_{})) : impl_{}
+        {
+        }
+
+        vector_storage(const allocator_type& a) noexcept : impl_{a}
+        {
+        }
+
+        vector_storage(size_type_ n, const allocator_type& a) : impl_{a}
+        {
+                impl_.beg_ = impl_.end_ = impl_.cap_ = detail::allocate_or_throw(impl_, n);
+                impl_.cap_ += static_cast<difference_type_>(n);
+        }
+
+        ~vector_storage()
+        {
+                if(impl_.beg_)
+                        alloc_traits_::deallocate(impl_, impl_.beg_, capacity());
+        }
+
+        // move construct:
+        vector_storage(vector_storage&& other) noexcept : impl_{std::move(other.impl_)}
+        {
+                other.impl_.beg_ = other.impl_.end_ = other.impl_.cap_ = pointer_{};
+        }
+
+        vector_storage(vector_storage&& other,
+                       const allocator_type& a) noexcept(alloc_traits_::is_always_equal::value)
+                : impl_{a}
+        {
+                if(alloc_traits_::is_always_equal::value ||
+                   get_allocator_ref() == other.get_allocator_ref())
+                {
+                        impl_.swap(other.impl_);
+                        return;
+                }
+
+                if(!other.empty())
+                        reallocation_::take_elements(*this, other);
+        }
+
+        // move assign:
+        vector_storage& operator=(vector_storage&& other) noexcept(
+                alloc_traits_::propagate_on_container_move_assignment::value ||
+                alloc_traits_::is_always_equal::value)
+        {
+                if(alloc_traits_::propagate_on_container_move_assignment::value ||
+                   alloc_traits_::is_always_equal::value ||
+                   get_allocator_ref() == other.get_allocator_ref())
+                {
+                        detail::destroy_elements(*this);
+                        deallocate();
+
+                        impl_.swap(other.impl_);
+
+                        if /*constexpr*/ (
+                                alloc_traits_::propagate_on_container_move_assignment::value)
+                                get_allocator_ref() = std::move(other.get_allocator_ref());
+
+                        return *this;
+                }
+
+                detail::assign_n(*this, other.size(), std::make_move_iterator(other.begin()));
+
+                detail::destroy_elements(other);
+                other.deallocate();
+
+                return *this;
+        }
+
+        // takes buffer of vector storage with the same allocator type, if allocators are equal:
+        template <typename OtherGrowthPolicy>
+        bool adopt(vector_storage<T, Allocator, OtherGrowthPolicy>& other) noexcept
+        {
+                if(!alloc_traits_::is_always_equal::value &&
+                   get_allocator_ref() != other.get_allocator_ref())
+                        return false;
+
+                detail::destroy_elements(*this);
+                deallocate();
+
+                impl_.beg_ = std::exchange(other.impl_.beg_, pointer_{});
+                impl_.end_ = std::exchange(other.impl_.end_, pointer_{});
+                impl_.cap_ = std::exchange(other.impl_.cap_, pointer_{});
+
+                return true;
+        }
+
+        // interface:
+        allocator_type& get_allocator_ref() noexcept
+        {
+                return static_cast<allocator_type&>(impl_);
+        }
+
+        const allocator_type& get_allocator_ref() const noexcept
+        {
+                return static_cast<const allocator_type&>(impl_);
+        }
+
+        //
+        void deallocate() noexcept
+        {
+                alloc_traits_::deallocate(impl_, impl_.beg_, capacity());
+                impl_.beg_ = impl_.end_ = impl_.cap_ = pointer_{};
+        }
+
+        //
+        template <typename... Args>
+        void construct(pointer_ location, Args&&... args)
+        {
+                alloc_traits_::construct(
+                        impl_, traits_::ptr_cast(location), std::forward<Args>(args)...);
+        }
+
+        void destroy(pointer_ location) noexcept
+        {
+                alloc_traits_::destroy(impl_, traits_::ptr_cast(location));
+        }
+
+        //
+        pointer_ begin() noexcept
+        {
+                return impl_.beg_;
+        }
+
+        const_pointer_ begin() const noexcept
+        {
+                return impl_.beg_;
+        }
+
+        //
+        pointer_ end() noexcept
+        {
+                return impl_.end_;
+        }
+
+        const_pointer_ end() const noexcept
+        {
+                return impl_.end_;
+        }
+
+        //
+        bool reallocate(size_type_ n)
+        {
+                return reallocation_::reallocate(*this, reallocation_::next_capacity(*this, n));
+        }
+
+        // moves elements into a buffer of exactly n elements, or frees the buffer, if n is 0:
+        bool shrink(size_type_ n)
+        {
+                if(n != 0)
+                        return reallocation_::reallocate(*this, n);
+
+                deallocate();
+                return true;
+        }
+
+        template <typename ForwardIterator>
+        bool reallocate_assign(size_type_ n, ForwardIterator first)
+        {
+                return reallocation_::assign(*this, n, first);
+        }
+
+        template <typename ForwardIterator>
+        bool reallocate_insert(pointer_ position, size_type_ n, ForwardIterator first)
+        {
+                return reallocation_::grow(*this, n, [&](pointer_ ptr) {
+                        detail::initialize_insert(*this, ptr, position, n, first);
+                });
+        }
+
+        template <typename... Args>
+        bool reallocate_emplace_back(Args&&... args)
+        {
+                return reallocation_::grow(*this, 1, [&](pointer_ ptr) {
+                        detail::initialize_emplace_back(*this, ptr, std::forward<Args>(args)...);
+                });
+        }
+
+        //
+        bool empty() const noexcept
+        {
+                return impl_.beg_ == impl_.end_;
+        }
+
+        bool full() const noexcept
+        {
+                return impl_.end_ == impl_.cap_;
+        }
+
+        //
+        void set_size(size_type_ n) noexcept
+        {
+                impl_.end_ = impl_.beg_ + static_cast<difference_type_>(n);
+        }
+
+        void inc_size(size_type_ n) noexcept
+        {
+                impl_.end_ += static_cast<difference_type_>(n);
+        }
+
+        void dec_size(size_type_ n) noexcept
+        {
+                impl_.end_ -= static_cast<difference_type_>(n);
+        }
+
+        //
+        size_type_ size() const noexcept
+        {
+                return static_cast<size_type_>(impl_.end_ - impl_.beg_);
+        }
+
+        size_type_ max_size() const noexcept
+        {
+                return alloc_traits_::max_size(impl_);
+        }
+
+        size_type_ capacity() const noexcept
+        {
+                return static_cast<size_type_>(impl_.cap_ - impl_.beg_);
+        }
+
+        //
+        void swap(vector_storage& other) noexcept(
+                alloc_traits_::propagate_on_container_swap::value ||
+                alloc_traits_::is_always_equal::value)
+        {
+                impl_.swap(other.impl_);
+                if(alloc_traits_::propagate_on_container_swap::value)
+                        std::swap(get_allocator_ref(), other.get_allocator_ref());
+        }
+
+private:
+        // replaces current buffer with the given one (current elements must be already
+        // destroyed or relocated):
+        void replace_buffer_(const buffer_& b, size_type_ n) noexcept
+        {
+                deallocate();
+
+                impl_.beg_ = b.ptr;
+                impl_.end_ = b.ptr + static_cast<difference_type_>(n);
+                impl_.cap_ = b.ptr + static_cast<difference_type_>(b.capacity);
+        }
+
+        //
+        implementation_ impl_;
+};
+
+template <typename T, typename Allocator, typename GrowthPolicy = geometric_growth<>>
+struct thin_vector_storage
+{
+        // types:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using growth_policy = GrowthPolicy;
+        using error_policy = typename detail::allocator_error_policy<Allocator>::type;
+
+        // friend declarations:
+        friend struct storage_traits<thin_vector_storage>;
+        friend struct detail::storage_reallocation<thin_vector_storage>;
+
+        // deleted copy constructor and copy assignment operator:
+        thin_vector_storage(const thin_vector_storage&) = delete;
+        thin_vector_storage& operator=(const thin_vector_storage&) = delete;
+
+protected: //
+        // additional types:
+        using traits_ = storage_traits<thin_vector_storage>;
+        using alloc_traits_ = std::allocator_traits<allocator_type>;
+
+        using pointer_ = typename alloc_traits_::pointer;
+        using const_pointer_ = typename alloc_traits_::const_pointer;
+
+        using size_type_ = typename alloc_traits_::size_type;
+        using difference_type_ = typename alloc_traits_::difference_type;
+
+        // requirement on pointer type (elements are addressed relative to the header):
+        static_assert(std::is_same<pointer_, value_type*>::value);
+
+        //
+        static constexpr bool is_trivially_relocatable =
+                detail::is_trivially_relocatable_with<T, Allocator>::value;
+        static constexpr bool is_trivially_default_constructible =
+                detail::is_trivially_default_constructible_with<T, Allocator>::value;
+
+        // heap block starts with the header, which is followed by elements:
+        struct header_
+        {
+                size_type_ size, capacity;
+        };
+
+        static constexpr std::size_t alignment_ = std::max(alignof(header_), alignof(T));
+        static constexpr std::size_t offset_ =
+                (sizeof(header_) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+        struct alignas(alignment_) block_
+        {
+                unsigned char bytes[alignment_];
+        };
+
+        using block_allocator_ = typename alloc_traits_::template rebind_alloc<block_>;
+        using block_alloc_traits_ = std::allocator_traits<block_allocator_>;
+
+        // heap block, which is obtained from the allocator (see detail::allocated_buffer):
+        struct buffer_
+        {
+                // allocates heap block with empty header (pointer is null on failure):
+                static buffer_ allocate(allocator_type& a, size_type_ capacity)
+                {
+                        block_allocator_ b{a};
+                        auto ptr = block_alloc_traits_::allocate(b, block_count_(capacity));
+
+                        if(!ptr)
+                                return {nullptr};
+
+                        return {::new(static_cast<void*>(ptr)) header_{0, capacity}};
+                }
+
+                void deallocate(allocator_type& a) const noexcept
+                {
+                        block_allocator_ b{a};
+                        block_alloc_traits_::deallocate(
+                                b, reinterpret_cast<block_*>(ptr), block_count_(ptr->capacity));
+                }
+
+                //
+                pointer_ elements() const noexcept
+                {
+                        return elements_(ptr);
+                }
+
+                //
+                header_* ptr;
+        };
+
+        using reallocation_ = detail::storage_reallocation<thin_vector_storage>;
+
+        struct implementation_ : allocator_type
+        {
+                implementation_() noexcept(noexcept(allocator_type{})) : allocator_type{}
+                {
+                }
+
+                implementation_(const allocator_type& a) noexcept : allocator_type{a}
+                {
+                }
+
+                implementation_(const implementation_&) = delete;
+                implementation_(implementation_&&) = default;
+
+                implementation_& operator=(const implementation_&) = delete;
+                implementation_& operator=(implementation_&&) = default;
+
+                //
+                void swap(implementation_& other) noexcept
+                {
+                        std::swap(ptr_, other.ptr_);
+                }
+
+                //
+                header_* ptr_{};
+        };
+
+        // construct/destroy:
+        thin_vector_storage() noexcept(noexcept(implementation_{})) : impl_{}
+        {
+        }
+
+        thin_vector_storage(const allocator_type& a) noexcept : impl_{a}
+        {
+        }
+
+        thin_vector_storage(size_type_ n, const allocator_type& a) : impl_{a}
+        {
+                if(n == 0)
+                        return;
+
+                impl_.ptr_ = buffer_::allocate(get_allocator_ref(), n).ptr;
+                if(!impl_.ptr_)
+                        detail::throw_exception<std::bad_alloc>();
+        }
+
+        ~thin_vector_storage()
+        {
+                deallocate();
+        }
+
+        // move construct:
+        thin_vector_storage(thin_vector_storage&& other) noexcept : impl_{std::move(other.impl_)}
+        {
+                other.impl_.ptr_ = nullptr;
+        }
+
+        thin_vector_storage(thin_vector_storage&& other,
+                            const allocator_type& a) noexcept(alloc_traits_::is_always_equal::value)
+                : impl_{a}
+        {
+                if(alloc_traits_::is_always_equal::value ||
+                   get_allocator_ref() == other.get_allocator_ref())
+                {
+                        impl_.swap(other.impl_);
+                        return;
+                }
+
+                if(!other.empty())
+                        reallocation_::take_elements(*this, other);
+        }
+
+        // move assign:
+        thin_vector_storage& operator=(thin_vector_storage&& other) noexcept(
+                alloc_traits_::propagate_on_container_move_assignment::value ||
+                alloc_traits_::is_always_equal::value)
+        {
+                if(alloc_traits_::propagate_on_container_move_assignment::value ||
+                   alloc_traits_::is_always_equal::value ||
+                   get_allocator_ref() == other.get_allocator_ref())
+                {
+                        detail::destroy_elements(*this);
+                        deallocate();
+
+                        impl_.swap(other.impl_);
+
+                        if /*constexpr*/ (
+                                alloc_traits_::propagate_on_container_move_assignment::value)
+                                get_allocator_ref() = std::move(other.get_allocator_ref());
+
+                        return *this;
+                }
+
+                detail::assign_n(*this, other.size(), std::make_move_iterator(other.begin()));
+
+                detail::destroy_elements(other);
+                other.deallocate();
+
+                return *this;
+        }
+
+        // interface:
+        allocator_type& get_allocator_ref() noexcept
+        {
+                return static_cast<allocator_type&>(impl_);
+        }
+
+        const allocator_type& get_allocator_ref() const noexcept
+        {
+                return static_cast<const allocator_type&>(impl_);
+        }
+
+        //
+        void deallocate() noexcept
+        {
+                if(impl_.ptr_)
+                        buffer_{impl_.ptr_}.deallocate(get_allocator_ref());
+
+                impl_.ptr_ = nullptr;
+        }
+
+        //
+        template <typename... Args>
+        void construct(pointer_ location, Args&&... args)
+        {
+                alloc_traits_::construct(impl_, location, std::forward<Args>(args)...);
+        }
+
+        void destroy(pointer_ location) noexcept
+        {
+                alloc_traits_::destroy(impl_, location);
+        }
+
+        //
+        pointer_ begin() noexcept
+        {
+                return impl_.ptr_ ? elements_(impl_.ptr_) : nullptr;
+        }
+
+        const_pointer_ begin() const noexcept
+        {
+                return impl_.ptr_ ? elements_(impl_.ptr_) : nullptr;
+        }
+
+        //
+        pointer_ end() noexcept
+        {
+                return impl_.ptr_ ? elements_(impl_.ptr_) + impl_.ptr_->size : nullptr;
+        }
+
+        const_pointer_ end() const noexcept
+        {
+                return impl_.ptr_ ? elements_(impl_.ptr_) + impl_.ptr_->size : nullptr;
+        }
+
+        //
+        bool reallocate(size_type_ n)
+        {
+                return reallocation_::reallocate(*this, reallocation_::next_capacity(*this, n));
+        }
+
+        // moves elements into a buffer of exactly n elements, or frees the buffer, if n is 0:
+        bool shrink(size_type_ n)
+        {
+                if(n != 0)
+                        return reallocation_::reallocate(*this, n);
+
+                deallocate();
+                return true;
+        }
+
+        template <typename ForwardIterator>
+        bool reallocate_assign(size_type_ n, ForwardIterator first)
+        {
+                return reallocation_::assign(*this, n, first);
+        }
+
+        template <typename ForwardIterator>
+        bool reallocate_insert(pointer_ position, size_type_ n, ForwardIterator first)
+        {
+                return reallocation_::grow(*this, n, [&](pointer_ ptr) {
+                        detail::initialize_insert(*this, ptr, position, n, first);
+                });
+        }
+
+        template <typename... Args>
+        bool reallocate_emplace_back(Args&&... args)
+        {
+                return reallocation_::grow(*this, 1, [&](pointer_ ptr) {
+                        detail::initialize_emplace_back(*this, ptr, std::forward<Args>(args)...);
+                });
+        }
+
+        //
+        bool empty() const noexcept
+        {
+                return !impl_.ptr_ || impl_.ptr_->size == 0;
+        }
+
+        bool full() const noexcept
+        {
+                return !impl_.ptr_ || impl_.ptr_->size == impl_.ptr_->capacity;
+        }
+
+        // (size of the storage without heap block can only be set to 0)
+        void set_size(size_type_ n) noexcept
+        {
+                if(impl_.ptr_)
+                        impl_.ptr_->size = n;
+        }
+
+        void inc_size(size_type_ n) noexcept
+        {
+                if(impl_.ptr_)
+                        impl_.ptr_->size += n;
+        }
+
+        void dec_size(size_type_ n) noexcept
+        {
+                if(impl_.ptr_)
+                        impl_.ptr_->size -= n;
+        }
+
+        //
+        size_type_ size() const noexcept
+        {
+                return impl_.ptr_ ? impl_.ptr_->size : 0;
+        }
+
+        size_type_ max_size() const noexcept
+        {
+                block_allocator_ a{get_allocator_ref()};
+                auto n = std::min(block_alloc_traits_::max_size(a),
+                                  std::numeric_limits<size_type_>::max() / sizeof(block_));
+
+                return std::min(alloc_traits_::max_size(impl_),
+                                (n * sizeof(block_) - offset_) / sizeof(value_type));
+        }
+
+        size_type_ capacity() const noexcept
+        {
+                return impl_.ptr_ ? impl_.ptr_->capacity : 0;
+        }
+
+        //
+        void swap(thin_vector_storage& other) noexcept(
+                alloc_traits_::propagate_on_container_swap::value ||
+                alloc_traits_::is_always_equal::value)
+        {
+                impl_.swap(other.impl_);
+                if(alloc_traits_::propagate_on_container_swap::value)
+                        std::swap(get_allocator_ref(), other.get_allocator_ref());
+        }
+
+private:
+        // number of blocks, which hold the header and the given number of elements:
+        static size_type_ block_count_(size_type_ capacity) noexcept
+        {
+                return (offset_ + capacity * sizeof(value_type) + sizeof(block_) - 1) /
+                       sizeof(block_);
+        }
+
+        static value_type* elements_(header_* ptr) noexcept
+        {
+                return reinterpret_cast<value_type*>(reinterpret_cast<unsigned char*>(ptr) +
+                                                     offset_);
+        }
+
+        // replaces current heap block with the given one (current elements must be already
+        // destroyed or relocated):
+        void replace_buffer_(const buffer_& b, size_type_ n) noexcept
+        {
+                deallocate();
+
+                impl_.ptr_ = b.ptr;
+                impl_.ptr_->size = n;
+        }
+
+        //
+        implementation_ impl_;
+};
+
+// double-ended storage, which keeps free capacity on both sides of its elements (elements can
+// be added and removed at the front in amortized constant time):
+template <typename T, typename Allocator, typename GrowthPolicy = geometric_growth<>>
+struct devector_storage
+{
+        // types:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using growth_policy = GrowthPolicy;
+        using error_policy = typename detail::allocator_error_policy<Allocator>::type;
+
+        // friend declarations:
+        friend struct storage_traits<devector_storage>;
+        friend struct detail::storage_reallocation<devector_storage>;
+
+        // deleted copy constructor and copy assignment operator:
+        devector_storage(const devector_storage&) = delete;
+        devector_storage& operator=(const devector_storage&) = delete;
+
+protected: //
+        // additional types:
+        using traits_ = storage_traits<devector_storage>;
+        using alloc_traits_ = std::allocator_traits<allocator_type>;
+
+        using pointer_ = typename alloc_traits_::pointer;
+        using const_pointer_ = typename alloc_traits_::const_pointer;
+
+        using size_type_ = typename alloc_traits_::size_type;
+        using difference_type_ = typename alloc_traits_::difference_type;
+
+        using buffer_ = detail::allocated_buffer<allocator_type>;
+        using reallocation_ = detail::storage_reallocation<devector_storage>;
+
+        //
+        static constexpr bool is_trivially_relocatable =
+                detail::is_trivially_relocatable_with<T, Allocator>::value;
+        static constexpr bool is_trivially_default_constructible =
+                detail::is_trivially_default_constructible_with<T, Allocator>::value;
+
+        // elements occupy [beg_, end_) range of the buffer [buf_, cap_):
+        struct implementation_ : allocator_type
+        {
+                implementation_() noexcept(noexcept(allocator_type{})) : allocator_type{}
+                {
+                }
+
+                implementation_(const allocator_type& a) noexcept : allocator_type{a}
+                {
+                }
+
+                implementation_(const implementation_&) = delete;
+                implementation_(implementation_&&) = default;
+
+                implementation_& operator=(const implementation_&) = delete;
+                implementation_& operator=(implementation_&&) = default;
+
+                //
+                void swap(implementation_& other) noexcept
+                {
+                        std::swap(buf_, other.buf_);
+                        std::swap(beg_, other.beg_);
+                        std::swap(end_, other.end_);
+                        std::swap(cap_, other.cap_);
+                }
+
+                //
+                pointer_ buf_{}, beg_{}, end_{}, cap_{};
+        };
+
+        // construct/destroy:
+        devector_storage() noexcept(noexcept(implementation_{})) : impl_{}
+        {
+        }
+
+        devector_storage(const allocator_type& a) noexcept : impl_{a}
+        {
+        }
+
+        devector_storage(size_type_ n, const allocator_type& a) : impl_{a}
+        {
+                impl_.buf_ = impl_.beg_ = impl_.end_ = impl_.cap_ =
+                        detail::allocate_or_throw(impl_, n);
+                impl_.cap_ += static_cast<difference_type_>(n);
+        }
+
+        ~devector_storage()
+        {
+                if(impl_.buf_)
+                        alloc_traits_::deallocate(impl_, impl_.buf_, buffer_length_());
+        }
+
+        // move construct:
+        devector_storage(devector_storage&& other) noexcept : impl_{std::move(other.impl_)}
+        {
+                other.impl_.buf_ = other.impl_.beg_ = other.impl_.end_ = other.impl_.cap_ =
+                        pointer_{};
+        }
+
+        devector_storage(devector_storage&& other,
+                         const allocator_type& a) noexcept(alloc_traits_::is_always_equal::value)
+                : impl_{a}
+        {
+                if(alloc_traits_::is_always_equal::value ||
+                   get_allocator_ref() == other.get_allocator_ref())
+                {
+                        impl_.swap(other.impl_);
+                        return;
+                }
+
+                if(!other.empty())
+                        reallocation_::take_elements(*this, other);
+        }
+
+        // move assign:
+        devector_storage& operator=(devector_storage&& other) noexcept(
+                alloc_traits_::propagate_on_container_move_assignment::value ||
+                alloc_traits_::is_always_equal::value)
+        {
+                if(alloc_traits_::propagate_on_container_move_assignment::value ||
+                   alloc_traits_::is_always_equal::value ||
+                   get_allocator_ref() == other.get_allocator_ref())
+                {
+                        detail::destroy_elements(*this);
+                        deallocate();
+
+                        impl_.swap(other.impl_);
+
+                        if /*constexpr*/ (
+                                alloc_traits_::propagate_on_container_move_assignment::value)
+                                get_allocator_ref() = std::move(other.get_allocator_ref());
+
+                        return *this;
+                }
+
+                detail::assign_n(*this, other.size(), std::make_move_iterator(other.begin()));
+
+                detail::destroy_elements(other);
+                other.deallocate();
+
+                return *this;
+        }
+
+        // interface:
+        allocator_type& get_allocator_ref() noexcept
+        {
+                return static_cast<allocator_type&>(impl_);
+        }
+
+        const allocator_type& get_allocator_ref() const noexcept
+        {
+                return static_cast<const allocator_type&>(impl_);
+        }
+
+        //
+        void deallocate() noexcept
+        {
+                alloc_traits_::deallocate(impl_, impl_.buf_, buffer_length_());
+                impl_.buf_ = impl_.beg_ = impl_.end_ = impl_.cap_ = pointer_{};
+        }
+
+        //
+        template <typename... Args>
+        void construct(pointer_ location, Args&&... args)
+        {
+                alloc_traits_::construct(
+                        impl_, traits_::ptr_cast(location), std::forward<Args>(args)...);
+        }
+
+        void destroy(pointer_ location) noexcept
+        {
+                alloc_traits_::destroy(impl_, traits_::ptr_cast(location));
+        }
+
+        //
+        pointer_ begin() noexcept
+        {
+                return impl_.beg_;
+        }
+
+        const_pointer_ begin() const noexcept
+        {
+                return impl_.beg_;
+        }
+
+        //
+        pointer_ end() noexcept
+        {
+                return impl_.end_;
+        }
+
+        const_pointer_ end() const noexcept
+        {
+                return impl_.end_;
+        }
+
+        // (capacity is counted from the first element, so reallocation makes room at the back)
+        bool reallocate(size_type_ n)
+        {
+                return make_room_(0, n - size());
+        }
+
+        bool reserve_front(size_type_ n)
+        {
+                return front_capacity() >= n || make_room_(n, 0);
+        }
+
+        // moves elements into a buffer of exactly n elements, or frees the buffer, if n is 0:
+        bool shrink(size_type_ n)
+        {
+                if(n != 0)
+                        return reallocation_::reallocate(*this, n);
+
+                deallocate();
+                return true;
+        }
+
+        template <typename ForwardIterator>
+        bool reallocate_assign(size_type_ n, ForwardIterator first)
+        {
+                return reallocation_::replace(*this, allocate_(n), n, [&](pointer_ ptr) {
+                        traits_::uninitialized_copy(*this, ptr, n, first);
+                });
+        }
+
+        template <typename ForwardIterator>
+        bool reallocate_insert(pointer_ position, size_type_ n, ForwardIterator first)
+        {
+                if(n > max_size() - size())
+                        return reallocation_::template fail<std::length_error>("");
+
+                auto sz = size() + n;
+                return reallocation_::replace(*this, allocate_(sz), sz, [&](pointer_ ptr) {
+                        detail::initialize_insert(*this, ptr, position, n, first);
+                });
+        }
+
+        // (new element is constructed first, since arguments might refer to existing elements)
+        template <typename... Args>
+        bool reallocate_emplace_back(Args&&... args)
+        {
+                value_type x{std::forward<Args>(args)...};
+                if(!make_room_(0, 1))
+                        return false;
+
+                construct(impl_.end_, std::move(x));
+                ++impl_.end_;
+
+                return true;
+        }
+
+        //
+        bool empty() const noexcept
+        {
+                return impl_.beg_ == impl_.end_;
+        }
+
+        bool full() const noexcept
+        {
+                return impl_.end_ == impl_.cap_;
+        }
+
+        //
+        void set_size(size_type_ n) noexcept
+        {
+                impl_.end_ = impl_.beg_ + static_cast<difference_type_>(n);
+        }
+
+        void inc_size(size_type_ n) noexcept
+        {
+                impl_.end_ += static_cast<difference_type_>(n);
+        }
+
+        void dec_size(size_type_ n) noexcept
+        {
+                impl_.end_ -= static_cast<difference_type_>(n);
+        }
+
+        //
+        void grow_front(size_type_ n) noexcept
+        {
+                impl_.beg_ -= static_cast<difference_type_>(n);
+        }
+
+        void shrink_front(size_type_ n) noexcept
         {
-                for(; n > 0; --n)
-                        detail::initialize_next(*this, x);
+                impl_.beg_ += static_cast<difference_type_>(n);
         }
 
-        template <typename InputIterator, typename = check_input_iterator<InputIterator>>
-        allocator_aware_storage(InputIterator first, InputIterator last,
-                                const allocator_type& a = allocator_type{})
-                : allocator_aware_storage{
-                          first, last, a,
-                          typename std::iterator_traits<InputIterator>::iterator_category{}}
+        //
+        size_type_ size() const noexcept
         {
+                return static_cast<size_type_>(impl_.end_ - impl_.beg_);
         }
 
-        allocator_aware_storage(std::initializer_list<value_type> il,
-                                const allocator_type& a = allocator_type{})
-                : allocator_aware_storage{il.begin(), il.end(), a, std::forward_iterator_tag{}}
+        size_type_ max_size() const noexcept
         {
+                return alloc_traits_::max_size(impl_);
         }
 
-        // copy/move construct:
-        allocator_aware_storage(const allocator_aware_storage& other)
-                : allocator_aware_storage{
-                          other, alloc_traits_::select_on_container_copy_construction(
-                                         other.get_allocator_ref())}
+        size_type_ capacity() const noexcept
         {
+                return static_cast<size_type_>(impl_.cap_ - impl_.beg_);
         }
 
-        allocator_aware_storage(allocator_aware_storage&&) = default;
+        size_type_ front_capacity() const noexcept
+        {
+                return static_cast<size_type_>(impl_.beg_ - impl_.buf_);
+        }
 
         //
-        allocator_aware_storage(const allocator_aware_storage& other, const allocator_type& a)
-                : allocator_aware_storage{traits_::size(other), a, principal_tag_{}}
+        void swap(devector_storage& other) noexcept(
+                alloc_traits_::propagate_on_container_swap::value ||
+                alloc_traits_::is_always_equal::value)
         {
-                for(auto& x : other)
-                        detail::initialize_next(*this, x);
+                impl_.swap(other.impl_);
+                if(alloc_traits_::propagate_on_container_swap::value)
+                        std::swap(get_allocator_ref(), other.get_allocator_ref());
         }
 
-        allocator_aware_storage(allocator_aware_storage&& other, const allocator_type& a)
-                : Storage{std::move(other), a}
+private:
+        size_type_ buffer_length_() const noexcept
         {
-                detail::destroy_elements(other);
-                traits_::set_size(other, 0);
+                return static_cast<size_type_>(impl_.cap_ - impl_.buf_);
         }
 
-        // copy/move assign:
-        allocator_aware_storage& operator=(const allocator_aware_storage& other)
+        // allocates new buffer for sz elements (free capacity is split evenly between both
+        // sides):
+        buffer_ allocate_(size_type_ sz)
         {
-                if(this == std::addressof(other))
-                        return *this;
-
-                // copy allocator if needed
-                if /*constexpr*/ (alloc_traits_::propagate_on_container_copy_assignment::value)
-                {
-                        // deallocate memory if allocators are not equal
-                        if(!alloc_traits_::is_always_equal::value &&
-                           this->get_allocator_ref() != other.get_allocator_ref())
-                        {
-                                detail::destroy_elements(*this);
-                                this->deallocate();
-                        }
-
-                        this->get_allocator_ref() = other.get_allocator_ref();
-                }
+                auto b = reallocation_::allocate(*this, reallocation_::next_capacity(*this, sz));
+                if(b.ptr)
+                        b.offset = static_cast<difference_type_>((b.capacity - sz) / 2);
 
-                return detail::assign_n(*this, traits_::size(other), traits_::begin(other));
+                return b;
         }
 
-        allocator_aware_storage& operator=(allocator_aware_storage&&) = default;
-
-        // returns copy of current allocator:
-        allocator_type get_allocator() const noexcept
+        // replaces current buffer with the given one, which holds n elements (current elements
+        // must be already destroyed or relocated):
+        void replace_buffer_(const buffer_& b, size_type_ n) noexcept
         {
-                return this->get_allocator_ref();
+                if(impl_.buf_)
+                        deallocate();
+
+                impl_.buf_ = b.ptr;
+                impl_.beg_ = b.elements();
+                impl_.end_ = impl_.beg_ + static_cast<difference_type_>(n);
+                impl_.cap_ = b.ptr + static_cast<difference_type_>(b.capacity);
         }
 
-protected:
-        ~allocator_aware_storage()
+        // moves elements, so that at least front_n elements fit before them, and back_n
+        // elements fit after them (remaining free capacity is split evenly between both sides;
+        // current buffer is reused, if it is at most half full):
+        bool make_room_(size_type_ front_n, size_type_ back_n)
         {
-                detail::destroy_elements(*this);
+                auto sz = size();
+                if(back_n > max_size() - sz || front_n > max_size() - sz - back_n)
+                        return reallocation_::template fail<std::length_error>("");
+
+                auto required = sz + front_n + back_n;
+                auto length = buffer_length_();
+
+                if(required > length || sz > length / 2)
+                        length = reallocation_::next_capacity(*this, required);
+
+                return length != 0 && move_buffer_(length, front_n + (length - required) / 2);
         }
 
-private: //
-        // additional types:
-        struct principal_tag_
+        // moves elements to the given offset in a buffer of the given length (buffer is reused,
+        // if its length doesn't change, and elements are relocatable):
+        template <bool E = is_trivially_relocatable, std::enable_if_t<E, int> = 0>
+        bool move_buffer_(size_type_ length, size_type_ offset)
         {
-        };
+                if(length != buffer_length_())
+                        return move_to_new_buffer_(length, offset);
 
-        using traits_ = storage_traits<allocator_aware_storage>;
-        using alloc_traits_ = std::allocator_traits<allocator_type>;
+                auto n = impl_.end_ - impl_.beg_;
+                auto target = impl_.buf_ + static_cast<difference_type_>(offset);
+                traits_::relocate(*this, begin(), end(), target);
 
-        // requirement on allocator type:
-        static_assert(std::is_same<value_type, typename alloc_traits_::value_type>::value);
+                impl_.beg_ = target;
+                impl_.end_ = target + n;
 
-        // additional constructors:
-        allocator_aware_storage(size_type n, const allocator_type& a, principal_tag_)
-                : Storage{n, a}
-        {
+                return true;
         }
 
-        template <typename InputIterator>
-        allocator_aware_storage(InputIterator first, InputIterator last, const allocator_type& a,
-                                std::input_iterator_tag)
-                : allocator_aware_storage{a}
+        template <bool E = is_trivially_relocatable, std::enable_if_t<!E, int> = 0>
+        bool move_buffer_(size_type_ length, size_type_ offset)
         {
-                for(; first != last; ++first)
-                {
-                        if(traits_::full(*this))
-                                traits_::reallocate(*this, traits_::capacity(*this) + 1);
-
-                        detail::initialize_next(*this, *first);
-                }
+                return move_to_new_buffer_(length, offset);
         }
 
-        template <typename ForwardIterator>
-        allocator_aware_storage(ForwardIterator first, ForwardIterator last,
-                                const allocator_type& a, std::forward_iterator_tag)
-                : allocator_aware_storage{
-                          static_cast<size_type>(std::distance(first, last)), a, principal_tag_{}}
+        // (elements are moved into new buffer, unless it is reused)
+        bool move_to_new_buffer_(size_type_ length, size_type_ offset)
         {
-                for_each_iter(first, last, [this](auto i) { detail::initialize_next(*this, *i); });
+                auto b = reallocation_::allocate(*this, length);
+                b.offset = static_cast<difference_type_>(offset);
+
+                return reallocation_::move(*this, b);
         }
+
+        //
+        implementation_ impl_;
 };
 
-template <typename T, typename Allocator>
-struct vector_storage
+template <typename T, std::size_t N, typename Allocator>
+struct small_vector_storage
 {
         // types:
         using value_type = T;
         using allocator_type = Allocator;
+        using error_policy = typename detail::allocator_error_policy<Allocator>::type;
 
-        // friend declaration:
-        friend struct storage_traits<vector_storage>;
+        // friend declarations:
+        friend struct storage_traits<small_vector_storage>;
+        friend struct detail::storage_reallocation<small_vector_storage>;
 
         // deleted copy constructor and copy assignment operator:
-        vector_storage(const vector_storage&) = delete;
-        vector_storage& operator=(const vector_storage&) = delete;
+        small_vector_storage(const small_vector_storage&) = delete;
+        small_vector_storage& operator=(const small_vector_storage&) = delete;
 
 protected: //
         // additional types:
-        using traits_ = storage_traits<vector_storage>;
+        using traits_ = storage_traits<small_vector_storage>;
         using alloc_traits_ = std::allocator_traits<allocator_type>;
 
         using pointer_ = typename alloc_traits_::pointer;
@@ -359,116 +2181,182 @@ protected: //
         using size_type_ = typename alloc_traits_::size_type;
         using difference_type_ = typename alloc_traits_::difference_type;
 
+        using buffer_ = detail::allocated_buffer<allocator_type>;
+        using reallocation_ = detail::storage_reallocation<small_vector_storage>;
+
+        //
+        static constexpr bool is_trivially_relocatable =
+                detail::is_trivially_relocatable_with<T, Allocator>::value;
+        static constexpr bool is_trivially_default_constructible =
+                detail::is_trivially_default_constructible_with<T, Allocator>::value;
+
+        // requirement on embedded capacity:
+        static_assert(N != 0);
+
         struct implementation_ : allocator_type
         {
                 implementation_() noexcept(noexcept(allocator_type{})) : allocator_type{}
                 {
+                        reset();
                 }
 
                 implementation_(const allocator_type& a) noexcept : allocator_type{a}
                 {
+                        reset();
                 }
 
-                implementation_(const implementation_&) = delete;
-                implementation_(implementation_&&) = default;
+                implementation_(allocator_type&& a) noexcept : allocator_type{std::move(a)}
+                {
+                        reset();
+                }
 
+                // pointers may refer to the embedded buffer, so the implementation can't be
+                // copied or moved as a whole
+                implementation_(const implementation_&) = delete;
                 implementation_& operator=(const implementation_&) = delete;
-                implementation_& operator=(implementation_&&) = default;
 
                 //
-                void swap(implementation_& other) noexcept
+                pointer_ embedded() noexcept
                 {
-                        std::swap(beg_, other.beg_);
-                        std::swap(end_, other.end_);
-                        std::swap(cap_, other.cap_);
+                        return std::pointer_traits<pointer_>::pointer_to(
+                                *reinterpret_cast<value_type*>(buffer_));
+                }
+
+                bool is_embedded() const noexcept
+                {
+                        return traits_::ptr_cast(beg_) ==
+                               reinterpret_cast<const value_type*>(buffer_);
+                }
+
+                void reset() noexcept
+                {
+                        beg_ = end_ = embedded();
+                        cap_ = beg_ + static_cast<difference_type_>(N);
+                }
+
+                // takes ownership of the memory, which was obtained from the allocator:
+                void take(implementation_& other) noexcept
+                {
+                        beg_ = other.beg_;
+                        end_ = other.end_;
+                        cap_ = other.cap_;
+                        other.reset();
                 }
 
                 //
                 pointer_ beg_{}, end_{}, cap_{};
+                alignas(value_type) unsigned char buffer_[N * sizeof(value_type)];
         };
 
         // construct/destroy:
-        vector_storage() noexcept(noexcept(implementation_{})) : impl_{}
+        small_vector_storage() noexcept(noexcept(implementation_{})) : impl_{}
         {
         }
 
-        vector_storage(const allocator_type& a) noexcept : impl_{a}
+        small_vector_storage(const allocator_type& a) noexcept : impl_{a}
         {
         }
 
-        vector_storage(size_type_ n, const allocator_type& a) : impl_{a}
+        small_vector_storage(size_type_ n, const allocator_type& a) : impl_{a}
         {
-                impl_.beg_ = impl_.end_ = impl_.cap_ = alloc_traits_::allocate(impl_, n);
+                if(n <= N)
+                        return;
+
+                impl_.beg_ = impl_.end_ = impl_.cap_ = detail::allocate_or_throw(impl_, n);
                 impl_.cap_ += static_cast<difference_type_>(n);
         }
 
-        ~vector_storage()
+        ~small_vector_storage()
         {
-                if(impl_.beg_)
+                if(!impl_.is_embedded())
                         alloc_traits_::deallocate(impl_, impl_.beg_, capacity());
         }
 
         // move construct:
-        vector_storage(vector_storage&& other) noexcept : impl_{std::move(other.impl_)}
+        small_vector_storage(small_vector_storage&& other) noexcept(
+                std::is_nothrow_move_constructible<value_type>::value)
+                : impl_{std::move(other.get_allocator_ref())}
         {
-                other.impl_.beg_ = other.impl_.end_ = other.impl_.cap_ = pointer_{};
+                take_(other);
         }
 
-        vector_storage(vector_storage&& other,
-                       const allocator_type& a) noexcept(alloc_traits_::is_always_equal::value)
+        small_vector_storage(small_vector_storage&& other, const allocator_type& a)
                 : impl_{a}
         {
-                if(alloc_traits_::is_always_equal::value ||
-                   get_allocator_ref() == other.get_allocator_ref())
+                if(!other.impl_.is_embedded() && equal_allocators_(other))
                 {
-                        impl_.swap(other.impl_);
+                        impl_.take(other.impl_);
                         return;
                 }
 
-                if(other.empty())
+                if(other.size() > N)
+                {
+                        reallocation_::take_elements(*this, other);
                         return;
+                }
 
-                impl_.beg_ = impl_.end_ = impl_.cap_ = alloc_traits_::allocate(impl_, other.size());
-                impl_.cap_ += static_cast<difference_type_>(other.size());
-
-                try
+                ECS_TRY
                 {
-                        for(auto& i : other)
+                        for_each_iter(other.begin(), other.end(), [this](auto i) {
                                 detail::initialize_next(*this, std::move(*i));
+                        });
                 }
-                catch(...)
+                ECS_CATCH(...)
                 {
                         detail::destroy_elements(*this);
-                        throw;
+                        ECS_RETHROW;
                 }
         }
 
         // move assign:
-        vector_storage& operator=(vector_storage&& other) noexcept(
-                alloc_traits_::propagate_on_container_move_assignment::value ||
-                alloc_traits_::is_always_equal::value)
+        small_vector_storage& operator=(small_vector_storage&& other) noexcept(
+                (alloc_traits_::propagate_on_container_move_assignment::value ||
+                 alloc_traits_::is_always_equal::value) &&
+                std::is_nothrow_move_constructible<value_type>::value &&
+                std::is_nothrow_move_assignable<value_type>::value)
         {
-                if(alloc_traits_::propagate_on_container_move_assignment::value ||
-                   alloc_traits_::is_always_equal::value ||
-                   get_allocator_ref() == other.get_allocator_ref())
+                if(this == std::addressof(other))
+                        return *this;
+
+                if(!equal_allocators_(other))
                 {
+                        if /*constexpr*/ (
+                                !alloc_traits_::propagate_on_container_move_assignment::value)
+                        {
+                                detail::assign_n(*this, other.size(),
+                                                 std::make_move_iterator(other.begin()));
+
+                                detail::destroy_elements(other);
+                                other.deallocate();
+
+                                return *this;
+                        }
+
+                        // memory of this storage can't outlive its allocator
                         detail::destroy_elements(*this);
                         deallocate();
+                }
 
-                        impl_.swap(other.impl_);
+                if /*constexpr*/ (alloc_traits_::propagate_on_container_move_assignment::value)
+                        get_allocator_ref() = std::move(other.get_allocator_ref());
 
-                        if /*constexpr*/ (
-                                alloc_traits_::propagate_on_container_move_assignment::value)
-                                get_allocator_ref() = std::move(other.get_allocator_ref());
+                if(other.impl_.is_embedded())
+                {
+                        // capacity of this storage is never less than N, so elements are
+                        // assigned in place
+                        traits_::assign(
+                                *this, other.size(), std::make_move_iterator(other.begin()));
+
+                        detail::destroy_elements(other);
+                        traits_::set_size(other, 0);
 
                         return *this;
                 }
 
-                detail::assign_n(*this, other.size(), std::make_move_iterator(other.begin()));
-
-                detail::destroy_elements(other);
-                other.deallocate();
+                detail::destroy_elements(*this);
+                deallocate();
 
+                impl_.take(other.impl_);
                 return *this;
         }
 
@@ -486,8 +2374,10 @@ protected: //
         //
         void deallocate() noexcept
         {
-                alloc_traits_::deallocate(impl_, impl_.beg_, capacity());
-                impl_.beg_ = impl_.end_ = impl_.cap_ = pointer_{};
+                if(!impl_.is_embedded())
+                        alloc_traits_::deallocate(impl_, impl_.beg_, capacity());
+
+                impl_.reset();
         }
 
         //
@@ -528,22 +2418,43 @@ protected: //
         //
         bool reallocate(size_type_ n)
         {
-                auto first = begin();
-                reallocate_initialize_n_(n, impl_.end_ - impl_.beg_, [this, &first](auto i) {
-                        this->construct(i, std::move_if_noexcept(*first)), (void)++first;
-                });
+                return reallocation_::reallocate(*this, reallocation_::next_capacity(*this, n));
+        }
+
+        // moves elements into the embedded buffer, if they fit, or into an allocated buffer of
+        // exactly n elements:
+        bool shrink(size_type_ n)
+        {
+                if(impl_.is_embedded())
+                        return false;
+
+                if(n > N)
+                        return reallocation_::reallocate(*this, n);
 
+                move_to_embedded_();
                 return true;
         }
 
         template <typename ForwardIterator>
         bool reallocate_assign(size_type_ n, ForwardIterator first)
         {
-                reallocate_initialize_n_(
-                        n, static_cast<difference_type_>(n),
-                        [this, &first](auto i) { this->construct(i, *first), (void)++first; });
+                return reallocation_::assign(*this, n, first);
+        }
 
-                return true;
+        template <typename ForwardIterator>
+        bool reallocate_insert(pointer_ position, size_type_ n, ForwardIterator first)
+        {
+                return reallocation_::grow(*this, n, [&](pointer_ ptr) {
+                        detail::initialize_insert(*this, ptr, position, n, first);
+                });
+        }
+
+        template <typename... Args>
+        bool reallocate_emplace_back(Args&&... args)
+        {
+                return reallocation_::grow(*this, 1, [&](pointer_ ptr) {
+                        detail::initialize_emplace_back(*this, ptr, std::forward<Args>(args)...);
+                });
         }
 
         //
@@ -590,50 +2501,148 @@ protected: //
         }
 
         //
-        void swap(vector_storage& other) noexcept(
-                alloc_traits_::propagate_on_container_swap::value ||
-                alloc_traits_::is_always_equal::value)
+        void swap(small_vector_storage& other)
         {
-                impl_.swap(other.impl_);
                 if(alloc_traits_::propagate_on_container_swap::value)
                         std::swap(get_allocator_ref(), other.get_allocator_ref());
+
+                if(!impl_.is_embedded() && !other.impl_.is_embedded())
+                {
+                        std::swap(impl_.beg_, other.impl_.beg_);
+                        std::swap(impl_.end_, other.impl_.end_);
+                        std::swap(impl_.cap_, other.impl_.cap_);
+
+                        return;
+                }
+
+                if(impl_.is_embedded() && other.impl_.is_embedded())
+                {
+                        auto& x = size() >= other.size() ? other : *this;
+                        auto& y = size() >= other.size() ? *this : other;
+
+                        auto n = x.size();
+                        auto f = y.begin() + static_cast<difference_type_>(n), l = y.end();
+
+                        std::swap_ranges(x.begin(), x.end(), y.begin());
+
+                        for_each_iter(f, l, [&x](auto i) {
+                                detail::initialize_next(x, std::move(*i));
+                        });
+                        for_each_iter(f, l, [&y](auto i) { traits_::destroy(y, i); });
+
+                        traits_::set_size(y, n);
+                        return;
+                }
+
+                // one storage owns allocated memory, and the other one relocates its embedded
+                // elements into the freed buffer
+                auto& x = impl_.is_embedded() ? *this : other;
+                auto& y = impl_.is_embedded() ? other : *this;
+
+                auto beg = y.impl_.beg_, end = y.impl_.end_, cap = y.impl_.cap_;
+                y.impl_.reset();
+
+                ECS_TRY
+                {
+                        y.take_(x);
+                }
+                ECS_CATCH(...)
+                {
+                        detail::destroy_elements(y);
+                        y.impl_.beg_ = beg, y.impl_.end_ = end, y.impl_.cap_ = cap;
+
+                        ECS_RETHROW;
+                }
+
+                x.impl_.beg_ = beg, x.impl_.end_ = end, x.impl_.cap_ = cap;
         }
 
 private:
-        template <typename Initializer>
-        void reallocate_initialize_n_(size_type_ sz, difference_type_ n, Initializer init)
+        bool equal_allocators_(const small_vector_storage& other) const noexcept
+        {
+                return alloc_traits_::is_always_equal::value ||
+                       get_allocator_ref() == other.get_allocator_ref();
+        }
+
+        // takes ownership of the allocated memory, or relocates embedded elements (this
+        // storage must be empty and must use its embedded buffer):
+        void take_(small_vector_storage& other)
+        {
+                if(!other.impl_.is_embedded())
+                {
+                        impl_.take(other.impl_);
+                        return;
+                }
+
+                relocate_embedded_(other);
+        }
+
+        template <bool E = is_trivially_relocatable, std::enable_if_t<E, int> = 0>
+        void relocate_embedded_(small_vector_storage& other) noexcept
+        {
+                traits_::relocate(*this, other.begin(), other.end(), begin());
+                traits_::set_size(*this, other.size());
+                traits_::set_size(other, 0);
+        }
+
+        template <bool E = is_trivially_relocatable, std::enable_if_t<!E, int> = 0>
+        void relocate_embedded_(small_vector_storage& other)
+        {
+                for_each_iter(other.begin(), other.end(), [this](auto i) {
+                        detail::initialize_next(*this, std::move(*i));
+                });
+
+                detail::destroy_elements(other);
+                traits_::set_size(other, 0);
+        }
+
+        // moves elements from allocated memory into the embedded buffer (they must fit):
+        template <bool E = is_trivially_relocatable, std::enable_if_t<E, int> = 0>
+        void move_to_embedded_() noexcept
         {
-                if(sz > max_size() || sz < capacity())
-                        throw std::length_error("");
+                auto beg = impl_.beg_, end = impl_.end_;
+                auto n = static_cast<size_type_>(impl_.cap_ - impl_.beg_);
 
-                auto current_size = size();
-                auto new_capacity = std::max(current_size + current_size, sz);
-                new_capacity = (new_capacity < current_size || new_capacity > max_size())
-                                       ? max_size()
-                                       : new_capacity;
+                impl_.reset();
+                traits_::relocate(*this, beg, end, begin());
+                traits_::set_size(*this, static_cast<size_type_>(end - beg));
 
-                auto ptr = alloc_traits_::allocate(impl_, new_capacity);
-                auto first = ptr, last = first + n;
+                alloc_traits_::deallocate(impl_, beg, n);
+        }
+
+        template <bool E = is_trivially_relocatable, std::enable_if_t<!E, int> = 0>
+        void move_to_embedded_()
+        {
+                auto beg = impl_.beg_, end = impl_.end_, cap = impl_.cap_;
+                impl_.reset();
 
-                try
+                ECS_TRY
                 {
-                        for(; first != last; ++first)
-                                init(first);
+                        for_each_iter(beg, end, [this](auto i) {
+                                detail::initialize_next(*this, std::move_if_noexcept(*i));
+                        });
                 }
-                catch(...)
+                ECS_CATCH(...)
                 {
-                        for_each_iter(ptr, first, [this](auto i) { this->destroy(i); });
-                        alloc_traits_::deallocate(impl_, ptr, new_capacity);
+                        detail::destroy_elements(*this);
+                        impl_.beg_ = beg, impl_.end_ = end, impl_.cap_ = cap;
 
-                        throw;
+                        ECS_RETHROW;
                 }
 
-                detail::destroy_elements(*this);
+                for_each_iter(beg, end, [this](auto i) { this->destroy(i); });
+                alloc_traits_::deallocate(impl_, beg, static_cast<size_type_>(cap - beg));
+        }
+
+        // replaces current buffer with the given one (current elements must be already
+        // destroyed or relocated):
+        void replace_buffer_(const buffer_& b, size_type_ n) noexcept
+        {
                 deallocate();
 
-                impl_.beg_ = ptr;
-                impl_.end_ = ptr + n;
-                impl_.cap_ = ptr + static_cast<difference_type_>(new_capacity);
+                impl_.beg_ = b.ptr;
+                impl_.end_ = b.ptr + static_cast<difference_type_>(n);
+                impl_.cap_ = b.ptr + static_cast<difference_type_>(b.capacity);
         }
 
         //
@@ -61,6 +61,26 @@ struct contiguous_container : Storage
                 return assign_n_(n, make_identity_iterator(std::addressof(u)));
         }
 
+        // cross-storage assignment:
+        template <typename S>
+        constexpr bool assign(const contiguous_container<S>& other)
+        {
+                return assign_n_(other.size(), other.data());
+        }
+
+        template <typename S>
+        constexpr bool assign(contiguous_container<S>&& other)
+        {
+                if(static_cast<const void*>(this) == static_cast<const void*>(&other))
+                        return true;
+
+                // take memory of the other container, if possible
+                if(traits::adopt(*this, other))
+                        return true;
+
+                return assign_move_(other);
+        }
+
         // iterators:
         constexpr iterator begin() noexcept
         {
@@ -163,6 +183,46 @@ struct contiguous_container : Storage
                 return resize_(sz, x);
         }
 
+        // resizes container, leaving new elements of trivial types uninitialized:
+        constexpr bool resize_default_init(size_type sz)
+        {
+                if(sz <= size())
+                        return resize_(sz);
+
+                if(sz > capacity() && !traits::reallocate(*this, sz))
+                        return false;
+
+                traits::append_default_initialized(*this, sz - size());
+                return true;
+        }
+
+        // appends n default-initialized elements, returns iterator to the first of them:
+        constexpr iterator reserve_and_append_uninitialized(size_type n)
+        {
+                auto index = static_cast<difference_type>(size());
+
+                if(n > max_size() - size() || !resize_default_init(size() + n))
+                        return end();
+
+                return begin() + index;
+        }
+
+        // passes uninitialized memory for at most max_n elements past the end to the writer, which
+        // returns the number of elements it has actually written (writer must construct elements
+        // of non-trivial types; if writer throws, size of the container does not change):
+        template <typename Writer>
+        constexpr bool append_with(size_type max_n, Writer writer)
+        {
+                if(max_n > max_size() - size() || !reserve(size() + max_n))
+                        return false;
+
+                size_type n = writer(end(), max_n);
+                assert(n <= max_n);
+
+                traits::set_size(*this, size() + n);
+                return true;
+        }
+
         constexpr bool reserve(size_type n)
         {
                 if(n <= capacity())
@@ -171,6 +231,38 @@ struct contiguous_container : Storage
                 return traits::reallocate(*this, n);
         }
 
+        // reserves free capacity for n elements before the first element of double-ended
+        // container:
+        template <bool E = traits::is_double_ended, std::enable_if_t<E, int> = 0>
+        constexpr bool reserve_front(size_type n)
+        {
+                return traits::reserve_front(*this, n);
+        }
+
+        // reserves memory, reporting failure to obtain it through the return value regardless
+        // of error policy of the storage:
+        constexpr bool try_reserve(size_type n)
+        {
+                return try_([&] { return reserve(n); }, [] { return false; });
+        }
+
+        // releases unused memory (including free capacity before the first element), so capacity
+        // becomes closer to max(n, size()) (returns false, if storage can't release memory, e.g.
+        // if its capacity is fixed):
+        constexpr bool shrink_to(size_type n)
+        {
+                n = std::max(n, size());
+                if(n >= capacity() && traits::front_capacity(*this) == 0)
+                        return false;
+
+                return traits::shrink(*this, n);
+        }
+
+        constexpr bool shrink_to_fit()
+        {
+                return shrink_to(size());
+        }
+
         // element access:
         constexpr reference operator[](size_type i) noexcept
         {
@@ -188,7 +280,7 @@ struct contiguous_container : Storage
         constexpr reference at(size_type i)
         {
                 if(i >= size())
-                        throw std::out_of_range("contiguous_container::at");
+                        detail::throw_exception<std::out_of_range>("contiguous_container::at");
 
                 return data()[i];
         }
@@ -196,7 +288,7 @@ struct contiguous_container : Storage
         constexpr const_reference at(size_type i) const
         {
                 if(i >= size())
-                        throw std::out_of_range("contiguous_container::at");
+                        detail::throw_exception<std::out_of_range>("contiguous_container::at");
 
                 return data()[i];
         }
@@ -217,13 +309,13 @@ struct contiguous_container : Storage
         constexpr reference back() noexcept
         {
                 assert(!empty());
-                return *(--end());
+                return *(end() - 1);
         }
 
         constexpr const_reference back() const noexcept
         {
                 assert(!empty());
-                return *(--end());
+                return *(end() - 1);
         }
 
         // data access:
@@ -241,8 +333,18 @@ struct contiguous_container : Storage
         template <typename... Args>
         constexpr iterator emplace_back(Args&&... args)
         {
-                if(full() && !traits::reallocate(*this, capacity() + 1))
-                        return end();
+                if(full())
+                        return emplace_back_slow_(std::forward<Args>(args)...);
+
+                auto position = traits::construct(*this, end(), std::forward<Args>(args)...);
+                return traits::inc_size(*this), position;
+        }
+
+        // constructs new element at the end (container must not be full):
+        template <typename... Args>
+        constexpr iterator emplace_back_unchecked(Args&&... args)
+        {
+                assert(!full());
 
                 auto position = traits::construct(*this, end(), std::forward<Args>(args)...);
                 return traits::inc_size(*this), position;
@@ -258,12 +360,89 @@ struct contiguous_container : Storage
                 return emplace_back(std::move(x));
         }
 
+        // appends element, reporting failure to obtain memory by returning end() regardless of
+        // error policy of the storage:
+        constexpr iterator try_push_back(const_reference x)
+        {
+                return try_([&] { return push_back(x); }, [this] { return end(); });
+        }
+
+        constexpr iterator try_push_back(value_type&& x)
+        {
+                return try_([&] { return push_back(std::move(x)); }, [this] { return end(); });
+        }
+
+        // appends elements of the given range (which must not refer to elements of the
+        // container), memory is reserved once, when range size is known:
+        template <typename InputIterator, typename = check_input_iterator<InputIterator>>
+        constexpr bool append(InputIterator first, InputIterator last)
+        {
+                return append_(first, last,
+                               typename std::iterator_traits<InputIterator>::iterator_category{});
+        }
+
+        // appends n elements, which are constructed from results of the given generator:
+        template <typename Generator>
+        ECS_CONSTEXPR20 bool append_n(size_type n, Generator gen)
+        {
+                if(!reserve_more_(n))
+                        return false;
+
+                auto first = end(), last = first;
+                auto sentinel = first + static_cast<difference_type>(n);
+
+                ECS_TRY
+                {
+                        for(; last != sentinel; ++last)
+                                traits::construct(*this, last, gen());
+                }
+                ECS_CATCH(...)
+                {
+                        destroy_range_(first, last);
+                        ECS_RETHROW;
+                }
+
+                traits::inc_size(*this, n);
+                return true;
+        }
+
         constexpr void pop_back() noexcept
         {
                 assert(!empty());
                 traits::dec_size(*this), traits::destroy(*this, end());
         }
 
+        // modifiers of double-ended containers:
+        template <bool E = traits::is_double_ended, std::enable_if_t<E, int> = 0,
+                  typename... Args>
+        constexpr iterator emplace_front(Args&&... args)
+        {
+                if(traits::front_capacity(*this) == 0)
+                        return emplace_front_slow_(std::forward<Args>(args)...);
+
+                traits::construct(*this, begin() - 1, std::forward<Args>(args)...);
+                return traits::grow_front(*this, 1), begin();
+        }
+
+        template <bool E = traits::is_double_ended, std::enable_if_t<E, int> = 0>
+        constexpr iterator push_front(const_reference x)
+        {
+                return emplace_front(x);
+        }
+
+        template <bool E = traits::is_double_ended, std::enable_if_t<E, int> = 0>
+        constexpr iterator push_front(value_type&& x)
+        {
+                return emplace_front(std::move(x));
+        }
+
+        template <bool E = traits::is_double_ended, std::enable_if_t<E, int> = 0>
+        constexpr void pop_front() noexcept
+        {
+                assert(!empty());
+                traits::destroy(*this, begin()), traits::shrink_front(*this, 1);
+        }
+
         //
         template <typename... Args>
         constexpr iterator emplace(const_iterator position, Args&&... args)
@@ -310,6 +489,21 @@ struct contiguous_container : Storage
                                  make_identity_iterator(std::addressof(x)));
         }
 
+        // inserts elements, reporting failure to obtain memory by returning end() regardless of
+        // error policy of the storage:
+        template <typename... Args>
+        constexpr iterator try_insert(const_iterator position, Args&&... args)
+        {
+                return try_([&] { return insert(position, std::forward<Args>(args)...); },
+                            [this] { return end(); });
+        }
+
+        constexpr iterator try_insert(const_iterator position,
+                                      std::initializer_list<value_type> il)
+        {
+                return try_([&] { return insert(position, il); }, [this] { return end(); });
+        }
+
         //
         constexpr iterator erase(const_iterator position)
         {
@@ -325,6 +519,15 @@ struct contiguous_container : Storage
                 return erase_n_(iter_cast_(first), last - first);
         }
 
+        // erases the element at the given position by replacing it with the last element (does
+        // not preserve order of elements; returns iterator to the replacing element):
+        constexpr iterator erase_unordered(const_iterator position)
+        {
+                assert(iter_check_(position) &&
+                       std::not_equal_to<const_iterator>{}(position, end()));
+                return replace_with_back_(iter_cast_(position));
+        }
+
         //
         constexpr void clear() noexcept
         {
@@ -376,6 +579,133 @@ private:
                 return true;
         }
 
+        //
+        template <typename S,
+                  bool E = std::is_same<value_type,
+                                        typename contiguous_container<S>::value_type>::value &&
+                           traits::is_trivially_relocatable &&
+                           contiguous_container<S>::traits::is_trivially_relocatable,
+                  std::enable_if_t<E, int> = 0>
+        constexpr bool assign_move_(contiguous_container<S>& other)
+        {
+                // relocate elements of the same type bytewise (current elements are kept, if
+                // memory can't be obtained)
+                if(!reserve(other.size()))
+                        return false;
+
+                clear();
+
+                if(detail::is_constant_evaluated())
+                        detail::copy_elements(data(), other.size(), other.data());
+                else if(!other.empty())
+                        std::memcpy(static_cast<void*>(data()),
+                                    static_cast<const void*>(other.data()),
+                                    other.size() * sizeof(value_type));
+
+                traits::set_size(*this, other.size());
+                contiguous_container<S>::traits::set_size(other, 0);
+
+                return true;
+        }
+
+        template <typename S,
+                  bool E = std::is_same<value_type,
+                                        typename contiguous_container<S>::value_type>::value &&
+                           traits::is_trivially_relocatable &&
+                           contiguous_container<S>::traits::is_trivially_relocatable,
+                  std::enable_if_t<!E, int> = 0>
+        constexpr bool assign_move_(contiguous_container<S>& other)
+        {
+                if(!assign_n_(other.size(), std::make_move_iterator(other.data())))
+                        return false;
+
+                other.clear();
+                return true;
+        }
+
+        // calls the given function, and converts exceptions, which report failure to obtain
+        // memory, into the result of the failure handler (storages, which report errors through
+        // return values, don't throw them):
+        template <typename Function, typename FailureHandler,
+                  bool E = traits::reports_errors, std::enable_if_t<E, int> = 0>
+        constexpr auto try_(Function f, FailureHandler)
+        {
+                return f();
+        }
+
+        template <typename Function, typename FailureHandler,
+                  bool E = traits::reports_errors, std::enable_if_t<!E, int> = 0>
+        ECS_CONSTEXPR20 auto try_(Function f, FailureHandler on_failure)
+        {
+                ECS_TRY
+                {
+                        return f();
+                }
+                ECS_CATCH(const std::bad_alloc&)
+                {
+                }
+                ECS_CATCH(const std::length_error&)
+                {
+                }
+
+                return on_failure();
+        }
+
+        //
+        constexpr bool reserve_more_(size_type n)
+        {
+                if(n <= capacity() - size())
+                        return true;
+
+                return n <= max_size() - size() && traits::reallocate(*this, size() + n);
+        }
+
+        template <typename InputIterator>
+        constexpr bool append_(InputIterator first, InputIterator last, std::input_iterator_tag)
+        {
+                for(iterator p{}; first != last; ++first)
+                        if((void)(p = emplace_back(*first)), p == end())
+                                return false;
+
+                return true;
+        }
+
+        template <typename ForwardIterator>
+        constexpr bool append_(ForwardIterator first, ForwardIterator last,
+                               std::forward_iterator_tag)
+        {
+                auto n = static_cast<size_type>(std::distance(first, last));
+                if(!reserve_more_(n))
+                        return false;
+
+                traits::uninitialized_copy(*this, end(), n, first);
+                traits::inc_size(*this, n);
+
+                return true;
+        }
+
+        //
+        template <typename... Args>
+        ECS_COLD constexpr iterator emplace_back_slow_(Args&&... args)
+        {
+                if(!traits::reallocate_emplace_back(*this, std::forward<Args>(args)...))
+                        return end();
+
+                return end() - 1;
+        }
+
+        // (new element is constructed first, since arguments might refer to existing elements)
+        template <typename... Args>
+        ECS_COLD constexpr iterator emplace_front_slow_(Args&&... args)
+        {
+                value_type x{std::forward<Args>(args)...};
+                if(!traits::reserve_front(*this, 1))
+                        return end();
+
+                traits::construct(*this, begin() - 1, std::move(x));
+                return traits::grow_front(*this, 1), begin();
+        }
+
         //
         template <typename... Args>
         constexpr bool resize_(size_type sz, const Args&... x)
@@ -390,27 +720,49 @@ private:
                         traits::set_size(*this, sz);
                 }
                 else
-                {
-                        for_each_iter(end(), target, [this, &x...](auto i) {
-                                traits::construct(*this, i, x...), traits::inc_size(*this);
-                        });
-                }
+                        append_n_(sz - size(), x...);
 
                 return true;
         }
 
+        constexpr void append_n_(size_type n)
+        {
+                for(; n > 0; --n)
+                        traits::construct(*this, end()), traits::inc_size(*this);
+        }
+
+        constexpr void append_n_(size_type n, const_reference x)
+        {
+                traits::uninitialized_copy(
+                        *this, end(), n, make_identity_iterator(std::addressof(x)));
+                traits::inc_size(*this, n);
+        }
+
         //
         template <typename InputIterator>
-        constexpr iterator insert_(const_iterator position, InputIterator first, InputIterator last,
-                                   std::input_iterator_tag)
+        ECS_CONSTEXPR20 iterator insert_(const_iterator position, InputIterator first,
+                                         InputIterator last, std::input_iterator_tag)
         {
+                // append elements, then rotate them into place
                 auto index = position - begin();
+                auto sz = size();
+                auto success = true;
 
-                for(auto p = iter_cast_(position); first != last; ++first, (void)++p)
-                        if((void)(p = emplace(p, *first)), p == end())
-                                return end();
+                ECS_TRY
+                {
+                        success = append_(first, last, std::input_iterator_tag{});
+                        traits::rotate(*this, begin() + index,
+                                       begin() + static_cast<difference_type>(sz), end());
+                }
+                ECS_CATCH(...)
+                {
+                        destroy_range_(begin() + static_cast<difference_type>(sz), end());
+                        traits::set_size(*this, sz);
 
-                return begin() + index;
+                        ECS_RETHROW;
+                }
+
+                return success ? begin() + index : end();
         }
 
         template <typename ForwardIterator>
@@ -427,50 +779,81 @@ private:
                 if(n == 0)
                         return position;
 
+                // shift preceding elements toward the front, if it is closer
+                if(traits::insert_front(*this, position, static_cast<size_type>(n), first))
+                        return position;
+
                 auto sz = static_cast<size_type>(n) + size();
                 if(sz > capacity() || sz < size())
                 {
                         auto index = position - begin();
-                        if(!traits::reallocate(*this, sz))
+                        if(!traits::reallocate_insert(
+                                   *this, position, static_cast<size_type>(n), first))
                                 return end();
 
-                        position = begin() + index;
+                        return begin() + index;
                 }
 
-                // relocate elements
-                auto m = std::min(n, end() - position);
-                auto last = end(), first_to_relocate = last - m, first_to_construct = position + m;
+                traits::insert(*this, position, static_cast<size_type>(n), first);
+                return position;
+        }
 
-                if(m != n)
-                {
-                        auto mid = first;
-                        std::advance(mid, m);
+        //
+        template <bool E = traits::is_trivially_relocatable, std::enable_if_t<E, int> = 0>
+        constexpr iterator erase_n_(iterator position, difference_type n = 1)
+        {
+                if(n == 0)
+                        return position;
 
-                        for_each_iter(first_to_construct, position + n, [this, &mid](auto i) {
-                                traits::construct(*this, i, *mid), traits::inc_size(*this), ++mid;
-                        });
-                }
+                // shift preceding elements instead, if the front is closer
+                if(traits::erase_front(*this, position, static_cast<size_type>(n)))
+                        return position + n;
+
+                destroy_range_(position, position + n);
+                traits::relocate(*this, position + n, end(), position);
+                traits::dec_size(*this, static_cast<size_type>(n));
+
+                return position;
+        }
 
-                for_each_iter(
-                        first_to_relocate, last, first_to_relocate + n, [this](auto i, auto j) {
-                                traits::construct(*this, j, std::move(*i)), traits::inc_size(*this);
-                        });
+        template <bool E = traits::is_trivially_relocatable, std::enable_if_t<!E, int> = 0>
+        constexpr iterator erase_n_(iterator position, difference_type n = 1)
+        {
+                if(n == 0)
+                        return position;
+
+                // shift preceding elements instead, if the front is closer
+                if(traits::erase_front(*this, position, static_cast<size_type>(n)))
+                        return position + n;
 
-                std::move_backward(position, first_to_relocate, last);
-                for_each_iter(position, first_to_construct, first, [](auto i, auto j) { *i = *j; });
+                destroy_range_(std::move(position + n, end(), position), end());
+                traits::dec_size(*this, static_cast<size_type>(n));
 
                 return position;
         }
 
         //
-        constexpr iterator erase_n_(iterator position, difference_type n = 1)
+        template <bool E = traits::is_trivially_relocatable, std::enable_if_t<E, int> = 0>
+        constexpr iterator replace_with_back_(iterator position) noexcept
         {
-                if(n != 0)
-                {
-                        destroy_range_(std::move(position + n, end(), position), end());
-                        traits::dec_size(*this, static_cast<size_type>(n));
-                }
+                auto last = end() - 1;
+                traits::destroy(*this, position);
+
+                if(position != last)
+                        traits::relocate(*this, last, end(), position);
+
+                traits::dec_size(*this, 1);
+                return position;
+        }
+
+        template <bool E = traits::is_trivially_relocatable, std::enable_if_t<!E, int> = 0>
+        constexpr iterator replace_with_back_(iterator position)
+        {
+                auto last = end() - 1;
+                if(position != last)
+                        *position = std::move(*last);
 
+                pop_back();
                 return position;
         }
 
@@ -493,45 +876,131 @@ private:
 };
 
 //
-template <typename Storage>
+namespace detail
+{
+// comparison of ranges of n elements (elements of suitable types are compared bytewise, unless
+// compared at compile time):
+template <typename T, std::enable_if_t<is_bytewise_equality_comparable<T>::value, int> = 0>
+constexpr bool equal_n(const T* x, const T* y, std::size_t n) noexcept
+{
+        if(is_constant_evaluated())
+                return std::equal(x, x + n, y);
+
+        return n == 0 || std::memcmp(x, y, n * sizeof(T)) == 0;
+}
+
+template <typename T, std::enable_if_t<!is_bytewise_equality_comparable<T>::value, int> = 0>
+constexpr bool equal_n(const T* x, const T* y, std::size_t n)
+{
+        return std::equal(x, x + n, y);
+}
+
+template <typename T, std::enable_if_t<is_bytewise_equality_comparable<T>::value, int> = 0>
+constexpr std::size_t mismatch_n(const T* x, const T* y, std::size_t n) noexcept
+{
+        if(is_constant_evaluated())
+                return static_cast<std::size_t>(std::mismatch(x, x + n, y).first - x);
+
+        return mismatch_bytes(x, y, n * sizeof(T)) / sizeof(T);
+}
+
+template <typename T, std::enable_if_t<!is_bytewise_equality_comparable<T>::value, int> = 0>
+constexpr std::size_t mismatch_n(const T* x, const T* y, std::size_t n)
+{
+        return static_cast<std::size_t>(std::mismatch(x, x + n, y).first - x);
+}
+
+// lexicographical comparison of ranges of m and n elements:
+template <typename T,
+          std::enable_if_t<is_bytewise_lexicographically_comparable<T>::value, int> = 0>
+constexpr bool lexicographical_compare_n(const T* x, std::size_t m, const T* y,
+                                         std::size_t n) noexcept
+{
+        if(is_constant_evaluated())
+                return std::lexicographical_compare(x, x + m, y, y + n);
+
+        auto k = std::min(m, n);
+        auto r = (k == 0) ? 0 : std::memcmp(x, y, k * sizeof(T));
+
+        return r < 0 || (r == 0 && m < n);
+}
+
+template <typename T,
+          std::enable_if_t<!is_bytewise_lexicographically_comparable<T>::value &&
+                                   is_bytewise_equality_comparable<T>::value,
+                           int> = 0>
+constexpr bool lexicographical_compare_n(const T* x, std::size_t m, const T* y, std::size_t n)
+{
+        auto k = std::min(m, n);
+        auto i = mismatch_n(x, y, k);
+
+        return (i == k) ? m < n : x[i] < y[i];
+}
+
+template <typename T,
+          std::enable_if_t<!is_bytewise_lexicographically_comparable<T>::value &&
+                                   !is_bytewise_equality_comparable<T>::value,
+                           int> = 0>
+constexpr bool lexicographical_compare_n(const T* x, std::size_t m, const T* y, std::size_t n)
+{
+        return std::lexicographical_compare(x, x + m, y, y + n);
+}
+
+//
+} // namespace detail
+
+// returns index of the first element, which differs in the given containers (or size of the
+// shorter container, if it is a prefix of the other one):
+template <typename Storage, typename S>
+constexpr auto mismatch_index(const contiguous_container<Storage>& lhs,
+                              const contiguous_container<S>& rhs) ->
+        typename contiguous_container<Storage>::size_type
+{
+        using size_type = typename contiguous_container<Storage>::size_type;
+        return static_cast<size_type>(
+                detail::mismatch_n(lhs.data(), rhs.data(), std::min(lhs.size(), rhs.size())));
+}
+
+//
+template <typename Storage, typename S>
 constexpr bool operator==(const contiguous_container<Storage>& lhs,
-                          const contiguous_container<Storage>& rhs)
+                          const contiguous_container<S>& rhs)
 {
-        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        return lhs.size() == rhs.size() && detail::equal_n(lhs.data(), rhs.data(), lhs.size());
 }
 
-template <typename Storage>
+template <typename Storage, typename S>
 constexpr bool operator!=(const contiguous_container<Storage>& lhs,
-                          const contiguous_container<Storage>& rhs)
+                          const contiguous_container<S>& rhs)
 {
         return !(lhs == rhs);
 }
 
 //
-template <typename Storage>
+template <typename Storage, typename S>
 constexpr bool operator<(const contiguous_container<Storage>& lhs,
-                         const contiguous_container<Storage>& rhs)
+                         const contiguous_container<S>& rhs)
 {
-        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        return detail::lexicographical_compare_n(lhs.data(), lhs.size(), rhs.data(), rhs.size());
 }
 
-template <typename Storage>
+template <typename Storage, typename S>
 constexpr bool operator>(const contiguous_container<Storage>& lhs,
-                         const contiguous_container<Storage>& rhs)
+                         const contiguous_container<S>& rhs)
 {
         return rhs < lhs;
 }
 
-template <typename Storage>
+template <typename Storage, typename S>
 constexpr bool operator<=(const contiguous_container<Storage>& lhs,
-                          const contiguous_container<Storage>& rhs)
+                          const contiguous_container<S>& rhs)
 {
         return !(lhs > rhs);
 }
 
-template <typename Storage>
+template <typename Storage, typename S>
 constexpr bool operator>=(const contiguous_container<Storage>& lhs,
-                          const contiguous_container<Storage>& rhs)
+                          const contiguous_container<S>& rhs)
 {
         return !(lhs < rhs);
 }
@@ -544,12 +1013,66 @@ constexpr void swap(contiguous_container<Storage>& lhs,
         lhs.swap(rhs);
 }
 
+// erases elements, which satisfy the given predicate, in a single pass (returns the number of
+// erased elements):
+template <typename Storage, typename Predicate>
+constexpr auto erase_if(contiguous_container<Storage>& c, Predicate pred)
+{
+        using traits = typename contiguous_container<Storage>::traits;
+        return traits::erase_if(c, [&pred](auto i) -> bool { return pred(*i); });
+}
+
+// erases elements at the given strictly increasing indices in a single pass (returns the number
+// of erased elements):
+template <typename Storage, typename IndexRange>
+constexpr auto erase_indices(contiguous_container<Storage>& c, const IndexRange& indices)
+{
+        using traits = typename contiguous_container<Storage>::traits;
+        using std::begin;
+        using std::end;
+
+        auto first = traits::begin(c);
+        auto next = begin(indices);
+        auto last = end(indices);
+
+        assert(std::is_sorted(next, last, std::less_equal<>{}) &&
+               (next == last || static_cast<std::size_t>(*std::prev(last)) < c.size()));
+
+        return traits::erase_if(c, [&](auto i) {
+                if(next == last || static_cast<std::size_t>(i - first) !=
+                                           static_cast<std::size_t>(*next))
+                        return false;
+
+                ++next;
+                return true;
+        });
+}
+
 // common container types:
 template <typename T, std::size_t N>
 using inplace_vector = contiguous_container<inplace_storage<T, N>>;
 
 template <typename T, typename Allocator = std::allocator<T>>
-using vector = contiguous_container<allocator_aware_storage<vector_storage<T, Allocator>>>;
+using fixed_vector = contiguous_container<fixed_storage<T, Allocator>>;
+
+template <typename T, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = geometric_growth<>>
+using vector = contiguous_container<
+        allocator_aware_storage<vector_storage<T, Allocator, GrowthPolicy>>>;
+
+template <typename T, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = geometric_growth<>>
+using thin_vector = contiguous_container<
+        allocator_aware_storage<thin_vector_storage<T, Allocator, GrowthPolicy>>>;
+
+template <typename T, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = geometric_growth<>>
+using devector = contiguous_container<
+        allocator_aware_storage<devector_storage<T, Allocator, GrowthPolicy>>>;
+
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+using small_vector =
+        contiguous_container<allocator_aware_storage<small_vector_storage<T, N, Allocator>>>;
 
 //
 } // namespace ecs
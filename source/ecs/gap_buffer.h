@@ -0,0 +1,330 @@
+// Copyright Ildus Nezametdinov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef GAP_BUFFER_H
+#define GAP_BUFFER_H
+
+#include "contiguous_container.h"
+
+namespace ecs
+{
+// sequence with a movable gap of free capacity: elements before the gap are kept in a vector,
+// which grows toward the gap, and elements after it are kept in a devector, which grows toward
+// the gap from the other side; insertion and erasure at the gap take amortized constant time
+// per element (elements after the gap are never shifted, since the devector only grows or
+// shrinks its front, regardless of relocatability of the elements), and moving the gap moves
+// only the elements it passes over (the gap is moved lazily, when an edit happens away from it):
+template <typename T, typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = geometric_growth<>>
+struct gap_buffer
+{
+        // types:
+        using front_container = vector<T, Allocator, GrowthPolicy>;
+        using back_container = devector<T, Allocator, GrowthPolicy>;
+
+        using value_type = T;
+        using allocator_type = Allocator;
+
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        using size_type = typename front_container::size_type;
+        using difference_type = typename front_container::difference_type;
+
+        // construct/copy/destroy:
+        gap_buffer() : front_{}, back_{}
+        {
+        }
+
+        explicit gap_buffer(const allocator_type& a) : front_{a}, back_{a}
+        {
+        }
+
+        gap_buffer(std::initializer_list<value_type> il, const allocator_type& a = {})
+                : front_{il, a}, back_{a}
+        {
+        }
+
+        // element access (elements are not relocated):
+        reference operator[](size_type i) noexcept
+        {
+                assert(i < size());
+                return (i < front_.size()) ? front_[i] : back_[i - front_.size()];
+        }
+
+        const_reference operator[](size_type i) const noexcept
+        {
+                assert(i < size());
+                return (i < front_.size()) ? front_[i] : back_[i - front_.size()];
+        }
+
+        //
+        reference front() noexcept
+        {
+                return (*this)[0];
+        }
+
+        const_reference front() const noexcept
+        {
+                return (*this)[0];
+        }
+
+        //
+        reference back() noexcept
+        {
+                return (*this)[size() - 1];
+        }
+
+        const_reference back() const noexcept
+        {
+                return (*this)[size() - 1];
+        }
+
+        // closes the gap by moving it to the end, so that all elements become contiguous
+        // (returned container remains valid until the next modification of this gap buffer,
+        // and can be modified directly, e.g. to append elements; returns null pointer, if the gap
+        // can't be moved):
+        front_container* contiguous_view()
+        {
+                return move_gap(size()) ? &front_ : nullptr;
+        }
+
+        // capacity:
+        bool empty() const noexcept
+        {
+                return front_.empty() && back_.empty();
+        }
+
+        size_type size() const noexcept
+        {
+                return front_.size() + back_.size();
+        }
+
+        // position of the gap (index of the first element after it):
+        size_type gap_position() const noexcept
+        {
+                return front_.size();
+        }
+
+        // modifiers:
+        // moves the gap to the given position (returns false, if memory can't be obtained):
+        bool move_gap(size_type position)
+        {
+                assert(position <= size());
+
+                auto gap = front_.size();
+                if(position < gap)
+                {
+                        auto first = front_.begin() + static_cast<difference_type>(position);
+
+                        if(!back_.reserve_front(gap - position))
+                                return false;
+
+                        // relocatable elements are moved at once, since the front of the devector
+                        // has enough room for them
+                        if /*constexpr*/ (back_container::traits::is_trivially_relocatable)
+                        {
+                                back_.insert(back_.begin(), std::make_move_iterator(first),
+                                             std::make_move_iterator(front_.end()));
+                                front_.erase(first, front_.end());
+
+                                return true;
+                        }
+
+                        // other elements are moved one by one, so that the gap only partially
+                        // moves, if an exception is thrown
+                        size_type n = 0;
+
+                        ECS_TRY
+                        {
+                                for(; n != gap - position; ++n)
+                                        back_.emplace_front(std::move(front_[gap - n - 1]));
+                        }
+                        ECS_CATCH(...)
+                        {
+                                front_.erase(front_.end() - static_cast<difference_type>(n),
+                                             front_.end());
+                                ECS_RETHROW;
+                        }
+
+                        front_.erase(first, front_.end());
+                }
+                else if(position > gap)
+                {
+                        auto last = back_.begin() + static_cast<difference_type>(position - gap);
+
+                        if(front_.insert(front_.end(), std::make_move_iterator(back_.begin()),
+                                         std::make_move_iterator(last)) == front_.end())
+                                return false;
+
+                        erase_after_gap_(position - gap);
+                }
+
+                return true;
+        }
+
+        // inserts elements at the given position, returns position of the first inserted element
+        // (or size(), if memory can't be obtained):
+        // (new element is constructed first, if the gap moves, since arguments might refer to
+        // existing elements)
+        template <typename... Args>
+        size_type emplace(size_type position, Args&&... args)
+        {
+                if(position == front_.size())
+                        return front_.emplace_back(std::forward<Args>(args)...) == front_.end()
+                                       ? size()
+                                       : position;
+
+                value_type x{std::forward<Args>(args)...};
+                if(!move_gap(position) || front_.emplace_back(std::move(x)) == front_.end())
+                        return size();
+
+                return position;
+        }
+
+        size_type insert(size_type position, const_reference x)
+        {
+                return emplace(position, x);
+        }
+
+        size_type insert(size_type position, value_type&& x)
+        {
+                return emplace(position, std::move(x));
+        }
+
+        size_type insert(size_type position, size_type n, const_reference x)
+        {
+                if(position == front_.size())
+                        return insert_at_gap_(n, x);
+
+                value_type y{x};
+                return move_gap(position) ? insert_at_gap_(n, y) : size();
+        }
+
+        // (range must not refer to elements of this gap buffer)
+        template <typename InputIterator, typename = check_input_iterator<InputIterator>>
+        size_type insert(size_type position, InputIterator first, InputIterator last)
+        {
+                if(first == last)
+                        return position;
+
+                if(!move_gap(position) || front_.insert(front_.end(), first, last) == front_.end())
+                        return size();
+
+                return position;
+        }
+
+        size_type insert(size_type position, std::initializer_list<value_type> il)
+        {
+                return insert(position, il.begin(), il.end());
+        }
+
+        // erases n elements starting at the given position, moving the gap to them (returns
+        // false, if the gap can't be moved):
+        bool erase(size_type position, size_type n = 1)
+        {
+                assert(n <= size() && position <= size() - n);
+
+                if(n == 0)
+                        return true;
+
+                if(position >= front_.size())
+                {
+                        if(!move_gap(position))
+                                return false;
+
+                        erase_after_gap_(n);
+                }
+                else
+                {
+                        if(!move_gap(position + n))
+                                return false;
+
+                        front_.erase(front_.end() - static_cast<difference_type>(n), front_.end());
+                }
+
+                return true;
+        }
+
+        void clear() noexcept
+        {
+                front_.clear();
+                back_.clear();
+        }
+
+        void swap(gap_buffer& other)
+        {
+                front_.swap(other.front_);
+                back_.swap(other.back_);
+        }
+
+        //
+        allocator_type get_allocator() const noexcept
+        {
+                return front_.get_allocator();
+        }
+
+private:
+        // erases n elements after the gap (the devector only shrinks its front, no elements are
+        // shifted):
+        void erase_after_gap_(size_type n) noexcept
+        {
+                using traits = typename back_container::traits;
+
+                auto first = back_.begin();
+                for_each_iter(first, first + static_cast<difference_type>(n),
+                              [this](auto i) { traits::destroy(back_, i); });
+
+                traits::shrink_front(back_, n);
+        }
+
+        //
+        size_type insert_at_gap_(size_type n, const_reference x)
+        {
+                auto position = front_.size();
+                if(n != 0 && front_.insert(front_.end(), n, x) == front_.end())
+                        return size();
+
+                return position;
+        }
+
+        //
+        front_container front_;
+        back_container back_;
+};
+
+// comparison operators:
+template <typename T, typename Allocator, typename GrowthPolicy>
+bool operator==(const gap_buffer<T, Allocator, GrowthPolicy>& lhs,
+                const gap_buffer<T, Allocator, GrowthPolicy>& rhs)
+{
+        if(lhs.size() != rhs.size())
+                return false;
+
+        for(std::size_t i = 0; i < lhs.size(); ++i)
+                if(!(lhs[i] == rhs[i]))
+                        return false;
+
+        return true;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+bool operator!=(const gap_buffer<T, Allocator, GrowthPolicy>& lhs,
+                const gap_buffer<T, Allocator, GrowthPolicy>& rhs)
+{
+        return !(lhs == rhs);
+}
+
+// specialized algorithms:
+template <typename T, typename Allocator, typename GrowthPolicy>
+void swap(gap_buffer<T, Allocator, GrowthPolicy>& lhs,
+          gap_buffer<T, Allocator, GrowthPolicy>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+        lhs.swap(rhs);
+}
+
+//
+} // namespace ecs
+
+#endif // GAP_BUFFER_H
@@ -0,0 +1,710 @@
+// Copyright Ildus Nezametdinov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#ifndef MAPPED_STORAGE_TYPES_H
+#define MAPPED_STORAGE_TYPES_H
+
+#include "contiguous_container.h"
+
+#include <system_error>
+#include <new>
+#include <cstdint>
+#include <cstdlib>
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ecs
+{
+namespace detail
+{
+inline std::size_t page_size() noexcept
+{
+        static const auto size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+}
+
+inline std::size_t round_up(std::size_t n, std::size_t alignment) noexcept
+{
+        return ((n + alignment - 1) / alignment) * alignment;
+}
+
+[[noreturn]] inline void throw_system_error(const char* what)
+{
+        throw_exception<std::system_error>(errno, std::system_category(), what);
+}
+
+//
+} // namespace detail
+
+// storage, which keeps elements in a memory-mapped file (number of elements is kept in the
+// header of the file, so the container can be restored by mapping the file again):
+template <typename T>
+struct mmap_file_storage
+{
+        // types:
+        using value_type = T;
+        using error_policy = returning_errors;
+
+        // friend declaration:
+        friend struct storage_traits<mmap_file_storage>;
+
+        // requirement on value type:
+        static_assert(std::is_trivially_copyable<value_type>::value);
+
+        // construct:
+        explicit mmap_file_storage(const char* path)
+        {
+                fd_ = ::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+                if(fd_ == -1)
+                        detail::throw_system_error("mmap_file_storage: open");
+
+                ECS_TRY
+                {
+                        open_();
+                }
+                ECS_CATCH(...)
+                {
+                        close_();
+                        ECS_RETHROW;
+                }
+        }
+
+        // move construct/assign:
+        mmap_file_storage(mmap_file_storage&& other) noexcept
+                : fd_{other.fd_}, base_{other.base_}, length_{other.length_}
+        {
+                other.fd_ = -1;
+                other.base_ = nullptr;
+                other.length_ = 0;
+        }
+
+        mmap_file_storage& operator=(mmap_file_storage&& other) noexcept
+        {
+                if(this == std::addressof(other))
+                        return *this;
+
+                close_();
+                swap(other);
+
+                return *this;
+        }
+
+        mmap_file_storage(const mmap_file_storage&) = delete;
+        mmap_file_storage& operator=(const mmap_file_storage&) = delete;
+
+        // flushes mapped memory to the file:
+        void sync()
+        {
+                if(base_ && ::msync(base_, length_, MS_SYNC) == -1)
+                        detail::throw_system_error("mmap_file_storage: msync");
+        }
+
+        // swap:
+        void swap(mmap_file_storage& other) noexcept
+        {
+                std::swap(fd_, other.fd_);
+                std::swap(base_, other.base_);
+                std::swap(length_, other.length_);
+        }
+
+protected:
+        ~mmap_file_storage()
+        {
+                close_();
+        }
+
+private: //
+        // file header:
+        struct header_
+        {
+                std::uint64_t magic;
+                std::uint64_t element_size;
+                std::uint64_t size;
+        };
+
+        static constexpr std::uint64_t magic_ = 0x6d6d61705f766563; // "mmap_vec"
+
+        static constexpr std::size_t data_offset_() noexcept
+        {
+                return ((sizeof(header_) + alignof(value_type) - 1) / alignof(value_type)) *
+                       alignof(value_type);
+        }
+
+        // interface (moved-from storage has no mapping, and is empty):
+        value_type* begin() noexcept
+        {
+                return base_ ? reinterpret_cast<value_type*>(base_ + data_offset_()) : nullptr;
+        }
+
+        const value_type* begin() const noexcept
+        {
+                return base_ ? reinterpret_cast<const value_type*>(base_ + data_offset_())
+                             : nullptr;
+        }
+
+        //
+        bool reallocate(std::size_t n)
+        {
+                if(n > storage_traits<mmap_file_storage>::max_size(*this) || n < capacity())
+                        return false;
+
+                auto new_capacity = std::max(capacity() + capacity(), n);
+                auto length = detail::round_up(
+                        data_offset_() + new_capacity * sizeof(value_type), detail::page_size());
+
+                if(::ftruncate(fd_, static_cast<off_t>(length)) == -1)
+                        return false;
+
+                auto base = map_(length);
+                if(!base)
+                        return false;
+
+                ::munmap(base_, length_);
+                base_ = base, length_ = length;
+
+                return true;
+        }
+
+        //
+        void set_size(std::size_t n) noexcept
+        {
+                assert(base_ || n == 0);
+                if(base_)
+                        header_ref_().size = n;
+        }
+
+        std::size_t size() const noexcept
+        {
+                if(!base_)
+                        return 0;
+
+                return static_cast<std::size_t>(
+                        reinterpret_cast<const header_*>(base_)->size);
+        }
+
+        std::size_t capacity() const noexcept
+        {
+                return base_ ? (length_ - data_offset_()) / sizeof(value_type) : 0;
+        }
+
+private:
+        header_& header_ref_() noexcept
+        {
+                return *reinterpret_cast<header_*>(base_);
+        }
+
+        unsigned char* map_(std::size_t length) noexcept
+        {
+                auto p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+                return (p == MAP_FAILED) ? nullptr : static_cast<unsigned char*>(p);
+        }
+
+        void open_()
+        {
+                struct stat st
+                {
+                };
+
+                if(::fstat(fd_, &st) == -1)
+                        detail::throw_system_error("mmap_file_storage: fstat");
+
+                auto length = static_cast<std::size_t>(st.st_size);
+                auto initialized = (length != 0);
+
+                if(!initialized)
+                {
+                        length = detail::round_up(data_offset_(), detail::page_size());
+                        if(::ftruncate(fd_, static_cast<off_t>(length)) == -1)
+                                detail::throw_system_error("mmap_file_storage: ftruncate");
+                }
+                else if(length < data_offset_())
+                        detail::throw_exception<std::system_error>(
+                                std::make_error_code(std::errc::invalid_argument),
+                                "mmap_file_storage: file is too small");
+
+                if((base_ = map_(length)) == nullptr)
+                        detail::throw_system_error("mmap_file_storage: mmap");
+
+                length_ = length;
+
+                if(!initialized)
+                {
+                        header_ref_() = header_{magic_, sizeof(value_type), 0};
+                        return;
+                }
+
+                auto& h = header_ref_();
+                if(h.magic != magic_ || h.element_size != sizeof(value_type) ||
+                   h.size > capacity())
+                        detail::throw_exception<std::system_error>(
+                                std::make_error_code(std::errc::invalid_argument),
+                                "mmap_file_storage: invalid header");
+        }
+
+        void close_() noexcept
+        {
+                if(base_)
+                        ::munmap(base_, length_);
+
+                if(fd_ != -1)
+                        ::close(fd_);
+
+                fd_ = -1;
+                base_ = nullptr;
+                length_ = 0;
+        }
+
+        //
+        int fd_{-1};
+        unsigned char* base_{};
+        std::size_t length_{};
+};
+
+// storage, which reserves a range of virtual addresses and commits its pages on demand (elements
+// are never relocated, so pointers to them remain valid until they are erased):
+template <typename T>
+struct reserved_storage
+{
+        // types:
+        using traits = storage_traits<reserved_storage>;
+        using value_type = T;
+        using error_policy = returning_errors;
+
+        // friend declaration:
+        friend struct storage_traits<reserved_storage>;
+
+        // constants:
+        static constexpr std::size_t default_reservation = std::size_t{1} << 32;
+
+        // construct:
+        reserved_storage() = default;
+
+        explicit reserved_storage(std::size_t max_capacity)
+                : max_capacity_{std::min(max_capacity, traits::max_ptrdiff / sizeof(value_type))}
+        {
+        }
+
+        // copy/move construct:
+        reserved_storage(const reserved_storage& other) : reserved_storage{other.max_capacity_}
+        {
+                if(traits::empty(other))
+                        return;
+
+                if(!reallocate(traits::size(other)))
+                        detail::throw_exception<std::bad_alloc>();
+
+                detail::initialize_n(*this, traits::size(other), traits::begin(other));
+        }
+
+        reserved_storage(reserved_storage&& other) noexcept
+                : base_{other.base_}
+                , size_{other.size_}
+                , capacity_{other.capacity_}
+                , max_capacity_{other.max_capacity_}
+        {
+                other.base_ = nullptr;
+                other.size_ = other.capacity_ = 0;
+        }
+
+        // copy/move assign:
+        reserved_storage& operator=(const reserved_storage& other)
+        {
+                if(this == std::addressof(other))
+                        return *this;
+
+                reserved_storage x{other};
+                swap(x);
+
+                return *this;
+        }
+
+        reserved_storage& operator=(reserved_storage&& other) noexcept
+        {
+                if(this == std::addressof(other))
+                        return *this;
+
+                release_();
+                swap(other);
+
+                return *this;
+        }
+
+        // swap:
+        void swap(reserved_storage& other) noexcept
+        {
+                std::swap(base_, other.base_);
+                std::swap(size_, other.size_);
+                std::swap(capacity_, other.capacity_);
+                std::swap(max_capacity_, other.max_capacity_);
+        }
+
+protected:
+        ~reserved_storage()
+        {
+                release_();
+        }
+
+private:
+        value_type* begin() noexcept
+        {
+                return reinterpret_cast<value_type*>(base_);
+        }
+
+        const value_type* begin() const noexcept
+        {
+                return reinterpret_cast<const value_type*>(base_);
+        }
+
+        //
+        bool reallocate(std::size_t n)
+        {
+                if(n > max_size() || n < capacity_)
+                        return false;
+
+                // address range is reserved on first request
+                if(!base_)
+                {
+                        auto p = ::mmap(nullptr, reserved_length_(), PROT_NONE,
+                                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+                        if(p == MAP_FAILED)
+                                return false;
+
+                        base_ = static_cast<unsigned char*>(p);
+                }
+
+                auto committed = committed_length_(capacity_);
+                auto new_capacity = std::min(std::max(capacity_ + capacity_, n), max_size());
+                auto length = committed_length_(new_capacity);
+
+                if(::mprotect(base_ + committed, length - committed, PROT_READ | PROT_WRITE) == -1)
+                        return false;
+
+                capacity_ = std::min(length / sizeof(value_type), max_size());
+                return true;
+        }
+
+        // decommits pages, which are not needed for n elements (elements stay in place):
+        bool shrink(std::size_t n)
+        {
+                auto committed = committed_length_(capacity_);
+                auto length = committed_length_(n);
+
+                // mapping over the pages releases them along with their commit charge
+                if(length != committed &&
+                   ::mmap(base_ + length, committed - length, PROT_NONE,
+                          MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1,
+                          0) == MAP_FAILED)
+                        return false;
+
+                capacity_ = std::min(length / sizeof(value_type), max_size());
+                return true;
+        }
+
+        //
+        void set_size(std::size_t n) noexcept
+        {
+                size_ = n;
+        }
+
+        std::size_t size() const noexcept
+        {
+                return size_;
+        }
+
+        std::size_t max_size() const noexcept
+        {
+                return max_capacity_;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+                return capacity_;
+        }
+
+private:
+        std::size_t reserved_length_() const noexcept
+        {
+                return detail::round_up(max_capacity_ * sizeof(value_type), detail::page_size());
+        }
+
+        std::size_t committed_length_(std::size_t n) const noexcept
+        {
+                return detail::round_up(n * sizeof(value_type), detail::page_size());
+        }
+
+        void release_() noexcept
+        {
+                if(!base_)
+                        return;
+
+                if /*constexpr*/ (!std::is_trivially_destructible<value_type>::value)
+                        detail::destroy_elements(*this);
+
+                ::munmap(base_, reserved_length_());
+
+                base_ = nullptr;
+                size_ = capacity_ = 0;
+        }
+
+        //
+        unsigned char* base_{};
+        std::size_t size_{}, capacity_{};
+        std::size_t max_capacity_{default_reservation / sizeof(value_type)};
+};
+
+#if defined(__linux__)
+// allocator-free storage for trivially relocatable elements: small buffers are obtained with
+// realloc, and buffers, which are larger than the threshold (in bytes), are anonymous mappings,
+// which grow with mremap (so growth costs O(pages) instead of O(bytes)):
+template <typename T, std::size_t Threshold = std::size_t{1} << 20>
+struct remap_storage
+{
+        // types:
+        using traits = storage_traits<remap_storage>;
+        using value_type = T;
+        using error_policy = returning_errors;
+
+        // friend declaration:
+        friend struct storage_traits<remap_storage>;
+
+        // requirements on value type:
+        static_assert(is_trivially_relocatable<value_type>::value);
+        static_assert(alignof(value_type) <= alignof(std::max_align_t));
+
+        // construct:
+        remap_storage() = default;
+
+        // copy/move construct:
+        remap_storage(const remap_storage& other) : remap_storage{}
+        {
+                if(traits::empty(other))
+                        return;
+
+                if(!reallocate(traits::size(other)))
+                        detail::throw_exception<std::bad_alloc>();
+
+                detail::initialize_n(*this, traits::size(other), traits::begin(other));
+        }
+
+        remap_storage(remap_storage&& other) noexcept
+                : data_{other.data_}, size_{other.size_}, length_{other.length_}
+        {
+                other.data_ = nullptr;
+                other.size_ = other.length_ = 0;
+        }
+
+        // copy/move assign:
+        remap_storage& operator=(const remap_storage& other)
+        {
+                if(this == std::addressof(other))
+                        return *this;
+
+                remap_storage x{other};
+                swap(x);
+
+                return *this;
+        }
+
+        remap_storage& operator=(remap_storage&& other) noexcept
+        {
+                if(this == std::addressof(other))
+                        return *this;
+
+                release_();
+                swap(other);
+
+                return *this;
+        }
+
+        // swap:
+        void swap(remap_storage& other) noexcept
+        {
+                std::swap(data_, other.data_);
+                std::swap(size_, other.size_);
+                std::swap(length_, other.length_);
+        }
+
+protected:
+        ~remap_storage()
+        {
+                release_();
+        }
+
+private:
+        value_type* begin() noexcept
+        {
+                return reinterpret_cast<value_type*>(data_);
+        }
+
+        const value_type* begin() const noexcept
+        {
+                return reinterpret_cast<const value_type*>(data_);
+        }
+
+        //
+        bool reallocate(std::size_t n)
+        {
+                if(n > traits::max_size(*this) || n < capacity())
+                        return false;
+
+                auto new_capacity = std::max(capacity() + capacity(), n);
+                new_capacity = (new_capacity > traits::max_size(*this)) ? traits::max_size(*this)
+                                                                        : new_capacity;
+
+                auto length = new_capacity * sizeof(value_type);
+                if(length == 0)
+                        return true;
+
+                if(length < threshold_())
+                {
+                        auto p = std::realloc(data_, length);
+                        if(!p)
+                                return false;
+
+                        data_ = static_cast<unsigned char*>(p);
+                        length_ = length;
+
+                        return true;
+                }
+
+                length = detail::round_up(length, detail::page_size());
+                if(is_mapped_())
+                {
+                        auto p = ::mremap(data_, length_, length, MREMAP_MAYMOVE);
+                        if(p == MAP_FAILED)
+                                return false;
+
+                        data_ = static_cast<unsigned char*>(p);
+                        length_ = length;
+
+                        return true;
+                }
+
+                auto p = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if(p == MAP_FAILED)
+                        return false;
+
+                traits::relocate(*this, begin(), traits::end(*this), static_cast<value_type*>(p));
+                std::free(data_);
+
+                data_ = static_cast<unsigned char*>(p);
+                length_ = length;
+
+                return true;
+        }
+
+        // shrinks buffer, so it holds n elements (mappings are shrunk in place, and become heap
+        // buffers, when they get smaller than the threshold):
+        bool shrink(std::size_t n)
+        {
+                auto length = n * sizeof(value_type);
+                if(length == 0)
+                {
+                        release_();
+                        return true;
+                }
+
+                if(length >= threshold_())
+                {
+                        length = detail::round_up(length, detail::page_size());
+                        if(::mremap(data_, length_, length, 0) == MAP_FAILED)
+                                return false;
+
+                        length_ = length;
+                        return true;
+                }
+
+                if(!is_mapped_())
+                {
+                        auto p = std::realloc(data_, length);
+                        if(!p)
+                                return false;
+
+                        data_ = static_cast<unsigned char*>(p);
+                        length_ = length;
+
+                        return true;
+                }
+
+                auto p = std::malloc(length);
+                if(!p)
+                        return false;
+
+                traits::relocate(*this, begin(), traits::end(*this), static_cast<value_type*>(p));
+                ::munmap(data_, length_);
+
+                data_ = static_cast<unsigned char*>(p);
+                length_ = length;
+
+                return true;
+        }
+
+        //
+        void set_size(std::size_t n) noexcept
+        {
+                size_ = n;
+        }
+
+        std::size_t size() const noexcept
+        {
+                return size_;
+        }
+
+        std::size_t capacity() const noexcept
+        {
+                return length_ / sizeof(value_type);
+        }
+
+private:
+        static std::size_t threshold_() noexcept
+        {
+                return detail::round_up(Threshold, detail::page_size());
+        }
+
+        bool is_mapped_() const noexcept
+        {
+                return length_ >= threshold_();
+        }
+
+        void release_() noexcept
+        {
+                if /*constexpr*/ (!std::is_trivially_destructible<value_type>::value)
+                        detail::destroy_elements(*this);
+
+                if(is_mapped_())
+                        ::munmap(data_, length_);
+                else
+                        std::free(data_);
+
+                data_ = nullptr;
+                size_ = length_ = 0;
+        }
+
+        //
+        unsigned char* data_{};
+        std::size_t size_{}, length_{};
+};
+#endif // defined(__linux__)
+
+// common container types:
+template <typename T>
+using mmap_vector = contiguous_container<mmap_file_storage<T>>;
+
+template <typename T>
+using stable_vector = contiguous_container<reserved_storage<T>>;
+
+#if defined(__linux__)
+template <typename T, std::size_t Threshold = std::size_t{1} << 20>
+using remap_vector = contiguous_container<remap_storage<T, Threshold>>;
+#endif // defined(__linux__)
+
+//
+} // namespace ecs
+
+#endif // MAPPED_STORAGE_TYPES_H
@@ -7,9 +7,91 @@
 
 #include "utility.h"
 #include <limits>
+#include <cstring>
 
 namespace ecs
 {
+// growth policies (each policy computes new capacity, given current size, requested capacity n,
+// max size and size of the element; the result is clamped to [n, max_size] by storage_traits):
+template <std::size_t Numerator = 2, std::size_t Denominator = 1>
+struct geometric_growth
+{
+        static_assert(Denominator != 0 && Numerator > Denominator);
+
+        template <typename Size>
+        static constexpr Size next_capacity(Size size, Size n, Size max_size, std::size_t) noexcept
+        {
+                constexpr auto num = static_cast<Size>(Numerator);
+                constexpr auto den = static_cast<Size>(Denominator);
+
+                // size * num / den, computed without overflow
+                auto q = size / den, r = size % den;
+                if(q > max_size / num)
+                        return max_size;
+
+                auto capacity = q * num + (r * num) / den;
+                return (capacity < n) ? n : capacity;
+        }
+};
+
+struct exact_growth
+{
+        template <typename Size>
+        static constexpr Size next_capacity(Size, Size n, Size, std::size_t) noexcept
+        {
+                return n;
+        }
+};
+
+// rounds allocation size up to the size class of typical allocators (four classes per each
+// power of two, as in jemalloc):
+template <typename Policy = geometric_growth<>>
+struct size_class_growth
+{
+        template <typename Size>
+        static constexpr Size next_capacity(Size size, Size n, Size max_size,
+                                            std::size_t element_size) noexcept
+        {
+                auto capacity = Policy::next_capacity(size, n, max_size, element_size);
+                if(capacity >= max_size)
+                        return max_size;
+
+                auto bytes = static_cast<std::size_t>(capacity) * element_size;
+                if(bytes <= 16)
+                        return static_cast<Size>(16 / element_size);
+
+                auto msb = std::size_t{1};
+                while(msb <= (bytes - 1) / 2)
+                        msb <<= 1;
+
+                auto step = std::max(msb / 4, std::size_t{1});
+                auto rounded = ((bytes + step - 1) / step) * step;
+
+                rounded /= element_size;
+                return (rounded > max_size) ? max_size : static_cast<Size>(rounded);
+        }
+};
+
+// rounds allocation size up to a multiple of the page size:
+template <typename Policy = geometric_growth<>, std::size_t PageSize = 4096>
+struct page_growth
+{
+        template <typename Size>
+        static constexpr Size next_capacity(Size size, Size n, Size max_size,
+                                            std::size_t element_size) noexcept
+        {
+                auto capacity = Policy::next_capacity(size, n, max_size, element_size);
+                if(capacity >= max_size)
+                        return max_size;
+
+                auto bytes = static_cast<std::size_t>(capacity) * element_size;
+                auto rounded = ((bytes + PageSize - 1) / PageSize) * PageSize;
+
+                rounded /= element_size;
+                return (rounded > max_size) ? max_size : static_cast<Size>(rounded);
+        }
+};
+
 template <typename Storage>
 struct storage_traits
 {
@@ -79,6 +161,11 @@ struct storage_traits
                 template <typename S>
                 using difference_type_trait = typename S::difference_type;
 
+                template <typename S>
+                using growth_policy_trait = typename S::growth_policy;
+                template <typename S>
+                using error_policy_trait = typename S::error_policy;
+
                 // types:
                 using pointer = select_type<value_type*, pointer_trait, storage_type>;
                 using const_pointer =
@@ -91,6 +178,11 @@ struct storage_traits
                 using difference_type = select_type<ptr_difference_type<pointer>,
                                                     difference_type_trait, storage_type>;
 
+                using growth_policy =
+                        select_type<geometric_growth<>, growth_policy_trait, storage_type>;
+                using error_policy =
+                        select_type<default_error_policy, error_policy_trait, storage_type>;
+
                 // member function detection traits:
                 template <typename S>
                 using construct_trait = decltype(std::declval<S>().construct(pointer{}));
@@ -103,10 +195,22 @@ struct storage_traits
                 using end_const_trait = decltype(std::declval<std::add_const_t<S>>().end());
 
                 template <typename S>
-                using reallocate_trait = decltype(std::declval<S>().reallocate(size_type{}));
+                using reallocate_trait =
+                        decltype(std::declval<S>().reallocate(std::declval<size_type>()));
                 template <typename S>
-                using reallocate_assign_trait =
-                        decltype(std::declval<S>().reallocate_assign(size_type{}, pointer{}));
+                using reallocate_assign_trait = decltype(
+                        std::declval<S>().reallocate_assign(std::declval<size_type>(), pointer{}));
+                template <typename S>
+                using reallocate_insert_trait = decltype(std::declval<S>().reallocate_insert(
+                        pointer{}, std::declval<size_type>(), pointer{}));
+                template <typename S>
+                using reallocate_emplace_back_trait =
+                        decltype(std::declval<S>().reallocate_emplace_back());
+                template <typename S>
+                using shrink_trait =
+                        decltype(std::declval<S>().shrink(std::declval<size_type>()));
+                template <typename S, typename Other>
+                using adopt_trait = decltype(std::declval<S>().adopt(std::declval<Other&>()));
 
                 template <typename S>
                 using empty_trait = decltype(std::declval<std::add_const_t<S>>().empty());
@@ -114,15 +218,21 @@ struct storage_traits
                 using full_trait = decltype(std::declval<std::add_const_t<S>>().full());
 
                 template <typename S>
-                using inc_size_trait = decltype(std::declval<S>().inc_size(size_type{}));
+                using inc_size_trait =
+                        decltype(std::declval<S>().inc_size(std::declval<size_type>()));
                 template <typename S>
-                using dec_size_trait = decltype(std::declval<S>().dec_size(size_type{}));
+                using dec_size_trait =
+                        decltype(std::declval<S>().dec_size(std::declval<size_type>()));
                 template <typename S>
                 using max_size_trait = decltype(std::declval<std::add_const_t<S>>().max_size());
 
                 template <typename S>
                 using swap_trait = decltype(std::declval<S>().swap(std::declval<S&>()));
 
+                template <typename S>
+                using front_capacity_trait =
+                        decltype(std::declval<std::add_const_t<S>>().front_capacity());
+
                 // member function existence flags:
                 static constexpr bool construct_exists = exists<construct_trait, storage_type>;
                 static constexpr bool destroy_exists = exists<destroy_trait, storage_type>;
@@ -135,6 +245,17 @@ struct storage_traits
                         exists_exact<bool, reallocate_trait, storage_type>;
                 static constexpr bool reallocate_assign_exists =
                         exists_exact<bool, reallocate_assign_trait, storage_type>;
+                static constexpr bool reallocate_insert_exists =
+                        exists_exact<bool, reallocate_insert_trait, storage_type>;
+                static constexpr bool reallocate_emplace_back_exists =
+                        exists_exact<bool, reallocate_emplace_back_trait, storage_type>;
+
+                static constexpr bool shrink_exists =
+                        exists_exact<bool, shrink_trait, storage_type>;
+
+                template <typename Other>
+                static constexpr bool adopt_exists =
+                        exists_exact<bool, adopt_trait, storage_type, Other>;
 
                 static constexpr bool empty_exists = exists_exact<bool, empty_trait, storage_type>;
                 static constexpr bool full_exists = exists_exact<bool, full_trait, storage_type>;
@@ -145,6 +266,40 @@ struct storage_traits
                         exists_exact<size_type, max_size_trait, storage_type>;
 
                 static constexpr bool swap_exists = exists<swap_trait, storage_type>;
+
+                // storage is double-ended, if it keeps free capacity before its first element
+                // (it must also implement reserve_front, grow_front and shrink_front):
+                static constexpr bool front_capacity_exists =
+                        exists_exact<size_type, front_capacity_trait, storage_type>;
+
+                // relocation trait (storage can override the default, which forbids bytewise
+                // relocation when construction or destruction of elements is customized):
+                template <typename S>
+                using trivially_relocatable_trait =
+                        std::integral_constant<bool, S::is_trivially_relocatable>;
+
+                using default_relocatability =
+                        std::integral_constant<bool,
+                                               ecs::is_trivially_relocatable<value_type>::value &&
+                                                       !construct_exists && !destroy_exists>;
+
+                static constexpr bool is_trivially_relocatable =
+                        select_type<default_relocatability, trivially_relocatable_trait,
+                                    storage_type>::value;
+
+                // default construction trait (storage can override the default, which forbids
+                // skipping initialization when construction of elements is customized):
+                template <typename S>
+                using trivially_default_constructible_trait =
+                        std::integral_constant<bool, S::is_trivially_default_constructible>;
+
+                using default_default_constructibility = std::integral_constant<
+                        bool, std::is_trivially_default_constructible<value_type>::value &&
+                                      !construct_exists>;
+
+                static constexpr bool is_trivially_default_constructible =
+                        select_type<default_default_constructibility,
+                                    trivially_default_constructible_trait, storage_type>::value;
         };
 
         // deduced types:
@@ -154,10 +309,37 @@ struct storage_traits
         using size_type = typename meta::size_type;
         using difference_type = typename meta::difference_type;
 
+        using growth_policy = typename meta::growth_policy;
+        using error_policy = typename meta::error_policy;
+
         // constants:
         static constexpr size_type max_ptrdiff =
                 static_cast<size_type>(std::numeric_limits<difference_type>::max());
 
+        static constexpr bool is_trivially_relocatable = meta::is_trivially_relocatable;
+        static constexpr bool reports_errors =
+                std::is_same<error_policy, returning_errors>::value;
+        static constexpr bool is_trivially_default_constructible =
+                meta::is_trivially_default_constructible;
+        static constexpr bool is_double_ended = meta::front_capacity_exists;
+
+        // elements can be copied bytewise from the given range, if they are stored contiguously
+        // and their construction is not customized:
+        template <typename Iterator>
+        static constexpr bool is_bytewise_copyable_from =
+                is_contiguous_iterator<Iterator>::value &&
+                std::is_same<std::remove_cv_t<typename std::iterator_traits<Iterator>::value_type>,
+                             value_type>::value &&
+                std::is_trivially_copyable<value_type>::value && is_trivially_relocatable;
+
+        // elements can be filled bytewise from the given range, if it repeats single element:
+        template <typename Iterator>
+        static constexpr bool is_bytewise_fillable_from =
+                is_identity_iterator<Iterator>::value &&
+                std::is_same<std::remove_cv_t<typename std::iterator_traits<Iterator>::value_type>,
+                             value_type>::value &&
+                std::is_trivially_copyable<value_type>::value && is_trivially_relocatable;
+
         // construct/destroy:
         template <bool E = meta::construct_exists, std::enable_if_t<E, int> = 0, typename... Args>
         static constexpr pointer construct(storage_type& storage, pointer location, Args&&... args)
@@ -254,6 +436,82 @@ struct storage_traits
                 return true;
         }
 
+        // releases unused memory, so the storage holds at least n elements (n must not be less
+        // than its size, or greater than its capacity; returns false, if storage can't do this):
+        template <bool E = meta::shrink_exists, std::enable_if_t<E, int> = 0>
+        static constexpr bool shrink(storage_type& storage, size_type n)
+        {
+                return storage.shrink(n);
+        }
+
+        template <bool E = meta::shrink_exists, std::enable_if_t<!E, int> = 0>
+        static constexpr bool shrink(storage_type&, size_type) noexcept
+        {
+                return false;
+        }
+
+        // reallocates storage, so it holds n more elements, which are inserted at the given
+        // position (storage can implement this, so each element is relocated only once):
+        template <bool E = meta::reallocate_insert_exists, std::enable_if_t<E, int> = 0,
+                  typename ForwardIterator>
+        static constexpr bool reallocate_insert(storage_type& storage, pointer position,
+                                                size_type n, ForwardIterator first)
+        {
+                return storage.reallocate_insert(position, n, first);
+        }
+
+        // (repeated element might belong to the storage, so it is copied before reallocation;
+        // other ranges must not refer to elements of the storage)
+        template <bool E = meta::reallocate_insert_exists, std::enable_if_t<!E, int> = 0,
+                  typename ForwardIterator>
+        static constexpr bool reallocate_insert(storage_type& storage, pointer position,
+                                                size_type n, ForwardIterator first)
+        {
+                return reallocate_insert_(
+                        storage, position, n, first, is_identity_iterator<ForwardIterator>{});
+        }
+
+        // reallocates storage and constructs new element at its end (storage can implement
+        // this, so the element is constructed before existing elements are relocated):
+        template <bool E = meta::reallocate_emplace_back_exists, std::enable_if_t<E, int> = 0,
+                  typename... Args>
+        static constexpr bool reallocate_emplace_back(storage_type& storage, Args&&... args)
+        {
+                return storage.reallocate_emplace_back(std::forward<Args>(args)...);
+        }
+
+        // (new element is constructed first, since arguments might refer to existing elements)
+        template <bool E = meta::reallocate_emplace_back_exists, std::enable_if_t<!E, int> = 0,
+                  typename... Args>
+        static constexpr bool reallocate_emplace_back(storage_type& storage, Args&&... args)
+        {
+                if /*constexpr*/ (!meta::reallocate_exists)
+                        return false;
+
+                value_type x(std::forward<Args>(args)...);
+                if(!reallocate(storage, capacity(storage) + 1))
+                        return false;
+
+                construct(storage, end(storage), std::move(x));
+                inc_size(storage);
+
+                return true;
+        }
+
+        // takes elements and memory of another storage (storage can implement this for storages,
+        // whose memory it can deallocate; returns false, if the other storage is not supported):
+        template <typename Other, std::enable_if_t<meta::template adopt_exists<Other>, int> = 0>
+        static bool adopt(storage_type& storage, Other& other)
+        {
+                return storage.adopt(other);
+        }
+
+        template <typename Other, std::enable_if_t<!meta::template adopt_exists<Other>, int> = 0>
+        static constexpr bool adopt(storage_type&, Other&) noexcept
+        {
+                return false;
+        }
+
         //
         template <bool E = meta::empty_exists, std::enable_if_t<E, int> = 0>
         static constexpr bool empty(const storage_type& storage) noexcept
@@ -332,6 +590,179 @@ struct storage_traits
                 return storage.capacity();
         }
 
+        // computes capacity, which should be allocated in order to hold at least n elements:
+        static constexpr size_type next_capacity(const storage_type& storage, size_type n) noexcept
+        {
+                auto max = max_size(storage);
+                auto capacity = growth_policy::next_capacity(
+                        size(storage), n, max, sizeof(value_type));
+
+                return (capacity < n) ? n : ((capacity > max) ? max : capacity);
+        }
+
+        // relocation (moves elements to possibly overlapping uninitialized memory; source
+        // objects are not destroyed, their lifetime ends implicitly):
+        template <bool E = is_trivially_relocatable, std::enable_if_t<E, int> = 0>
+        static constexpr void relocate(storage_type&, pointer first, pointer last,
+                                       pointer d_first) noexcept
+        {
+                if(first == last)
+                        return;
+
+                if(detail::is_constant_evaluated())
+                        detail::move_elements(ptr_cast(first), ptr_cast(last), ptr_cast(d_first));
+                else
+                        std::memmove(static_cast<void*>(ptr_cast(d_first)),
+                                     static_cast<const void*>(ptr_cast(first)),
+                                     static_cast<std::size_t>(last - first) * sizeof(value_type));
+        }
+
+        // rotates elements of the storage, so that middle becomes the first element of the range
+        // (elements are relocated bytewise, the shorter part is stashed in spare capacity of the
+        // storage, if it fits there, otherwise elements are rotated in place):
+        template <bool E = is_trivially_relocatable, std::enable_if_t<E, int> = 0>
+        static ECS_CONSTEXPR20 void rotate(storage_type& storage, pointer first, pointer middle,
+                                           pointer last)
+        {
+                if(first == middle || middle == last)
+                        return;
+
+                auto m = static_cast<std::size_t>(middle - first);
+                auto k = static_cast<std::size_t>(last - middle);
+
+                if(detail::is_constant_evaluated() ||
+                   capacity(storage) - size(storage) < std::min(m, k))
+                {
+                        std::rotate(first, middle, last);
+                        return;
+                }
+
+                auto x = ptr_cast(first), y = ptr_cast(middle);
+                auto buffer = ptr_cast(end(storage));
+
+                if(m <= k)
+                {
+                        std::memcpy(static_cast<void*>(buffer), static_cast<const void*>(x),
+                                    m * sizeof(value_type));
+                        std::memmove(static_cast<void*>(x), static_cast<const void*>(y),
+                                     k * sizeof(value_type));
+                        std::memcpy(static_cast<void*>(x + k), static_cast<const void*>(buffer),
+                                    m * sizeof(value_type));
+                }
+                else
+                {
+                        std::memcpy(static_cast<void*>(buffer), static_cast<const void*>(y),
+                                    k * sizeof(value_type));
+                        std::memmove(static_cast<void*>(x + k), static_cast<const void*>(x),
+                                     m * sizeof(value_type));
+                        std::memcpy(static_cast<void*>(x), static_cast<const void*>(buffer),
+                                    k * sizeof(value_type));
+                }
+        }
+
+        template <bool E = is_trivially_relocatable, std::enable_if_t<!E, int> = 0>
+        static ECS_CONSTEXPR20 void rotate(storage_type&, pointer first, pointer middle,
+                                           pointer last)
+        {
+                std::rotate(first, middle, last);
+        }
+
+        // copies n elements from the given range into uninitialized memory (on exception all
+        // constructed elements are destroyed), returns iterator past the last copied element:
+        template <typename ForwardIterator,
+                  std::enable_if_t<is_bytewise_copyable_from<ForwardIterator>, int> = 0>
+        static constexpr ForwardIterator uninitialized_copy(storage_type&, pointer target,
+                                                            size_type n,
+                                                            ForwardIterator first) noexcept
+        {
+                if(detail::is_constant_evaluated())
+                        detail::copy_elements(ptr_cast(target), n, first);
+                else if(n != 0)
+                        std::memcpy(static_cast<void*>(ptr_cast(target)),
+                                    static_cast<const void*>(to_address(first)),
+                                    n * sizeof(value_type));
+
+                return first + static_cast<difference_type>(n);
+        }
+
+        template <typename ForwardIterator,
+                  std::enable_if_t<is_bytewise_fillable_from<ForwardIterator>, int> = 0>
+        static constexpr ForwardIterator uninitialized_copy(storage_type&, pointer target,
+                                                            size_type n,
+                                                            ForwardIterator first) noexcept
+        {
+                if(detail::is_constant_evaluated())
+                        detail::fill_elements(ptr_cast(target), n, *first);
+                else
+                        detail::broadcast_fill(ptr_cast(target), n, *first);
+
+                return first;
+        }
+
+        template <typename ForwardIterator,
+                  std::enable_if_t<!is_bytewise_copyable_from<ForwardIterator> &&
+                                           !is_bytewise_fillable_from<ForwardIterator>,
+                                   int> = 0>
+        static ECS_CONSTEXPR20 ForwardIterator uninitialized_copy(storage_type& storage,
+                                                                  pointer target, size_type n,
+                                                                  ForwardIterator first)
+        {
+                auto last = target, sentinel = target + static_cast<difference_type>(n);
+
+                ECS_TRY
+                {
+                        for(; last != sentinel; ++last, (void)++first)
+                                construct(storage, last, *first);
+                }
+                ECS_CATCH(...)
+                {
+                        for_each_iter(target, last, [&storage](auto i) { destroy(storage, i); });
+                        ECS_RETHROW;
+                }
+
+                return first;
+        }
+
+        // double-ended storages (elements can be added and removed at the front, front capacity
+        // is the number of elements, which fit before the first element without reallocation):
+        template <bool E = is_double_ended, std::enable_if_t<E, int> = 0>
+        static constexpr size_type front_capacity(const storage_type& storage) noexcept
+        {
+                return storage.front_capacity();
+        }
+
+        template <bool E = is_double_ended, std::enable_if_t<!E, int> = 0>
+        static constexpr size_type front_capacity(const storage_type&) noexcept
+        {
+                return 0;
+        }
+
+        template <bool E = is_double_ended, std::enable_if_t<E, int> = 0>
+        static constexpr bool reserve_front(storage_type& storage, size_type n)
+        {
+                return storage.reserve_front(n);
+        }
+
+        template <bool E = is_double_ended, std::enable_if_t<!E, int> = 0>
+        static constexpr bool reserve_front(storage_type&, size_type) noexcept
+        {
+                return false;
+        }
+
+        // moves the first element n positions backward (new elements must be constructed before
+        // it), or forward (removed elements must be destroyed):
+        template <bool E = is_double_ended, std::enable_if_t<E, int> = 0>
+        static constexpr void grow_front(storage_type& storage, size_type n) noexcept
+        {
+                storage.grow_front(n);
+        }
+
+        template <bool E = is_double_ended, std::enable_if_t<E, int> = 0>
+        static constexpr void shrink_front(storage_type& storage, size_type n) noexcept
+        {
+                storage.shrink_front(n);
+        }
+
         // swap:
         template <bool E = meta::swap_exists, std::enable_if_t<E, int> = 0>
         static constexpr void swap(storage_type& lhs,
@@ -361,7 +792,39 @@ struct storage_traits
         }
 
         // assignment:
-        template <typename ForwardIterator>
+        template <typename ForwardIterator,
+                  std::enable_if_t<is_bytewise_copyable_from<ForwardIterator>, int> = 0>
+        static constexpr void assign(storage_type& storage, size_type n,
+                                     ForwardIterator first) noexcept
+        {
+                // source range might overlap with elements of the storage
+                if(detail::is_constant_evaluated())
+                        detail::copy_elements(ptr_cast(begin(storage)), n, first);
+                else if(n != 0)
+                        std::memmove(static_cast<void*>(ptr_cast(begin(storage))),
+                                     static_cast<const void*>(to_address(first)),
+                                     n * sizeof(value_type));
+
+                set_size(storage, n);
+        }
+
+        template <typename ForwardIterator,
+                  std::enable_if_t<is_bytewise_fillable_from<ForwardIterator>, int> = 0>
+        static constexpr void assign(storage_type& storage, size_type n,
+                                     ForwardIterator first) noexcept
+        {
+                if(detail::is_constant_evaluated())
+                        detail::fill_elements(ptr_cast(begin(storage)), n, *first);
+                else
+                        detail::broadcast_fill(ptr_cast(begin(storage)), n, *first);
+
+                set_size(storage, n);
+        }
+
+        template <typename ForwardIterator,
+                  std::enable_if_t<!is_bytewise_copyable_from<ForwardIterator> &&
+                                           !is_bytewise_fillable_from<ForwardIterator>,
+                                   int> = 0>
         static constexpr void assign(storage_type& storage, size_type n, ForwardIterator first)
         {
                 if(n > size(storage))
@@ -383,6 +846,357 @@ struct storage_traits
                         set_size(storage, n);
                 }
         }
+
+        // appends n default-initialized elements (storage must have enough capacity):
+        template <bool E = is_trivially_default_constructible, std::enable_if_t<E, int> = 0>
+        static constexpr void append_default_initialized(storage_type& storage, size_type n)
+        {
+                set_size(storage, size(storage) + n);
+        }
+
+        template <bool E = is_trivially_default_constructible, std::enable_if_t<!E, int> = 0>
+        static constexpr void append_default_initialized(storage_type& storage, size_type n)
+        {
+                for(; n > 0; --n)
+                        (void)construct(storage, end(storage)), inc_size(storage);
+        }
+
+        // removes elements, for which the given predicate (called once for each element's
+        // pointer, in order) returns true, preserving order of the remaining elements; kept
+        // elements are relocated in runs (returns the number of removed elements):
+        template <bool E = is_trivially_relocatable, std::enable_if_t<E, int> = 0,
+                  typename Predicate>
+        static ECS_CONSTEXPR20 size_type erase_if(storage_type& storage, Predicate pred)
+        {
+                auto first = begin(storage), last = end(storage);
+                auto target = first, run = first, i = first;
+
+                // [run, i) is a run of kept elements, which is not yet relocated to target
+                auto flush = [&](pointer run_end) noexcept
+                {
+                        relocate(storage, run, run_end, target);
+                        target += run_end - run;
+                };
+
+                ECS_TRY
+                {
+                        for(; i != last; ++i)
+                        {
+                                if(!pred(i))
+                                        continue;
+
+                                flush(i);
+                                destroy(storage, i);
+                                run = i + 1;
+                        }
+                }
+                ECS_CATCH(...)
+                {
+                        flush(last);
+                        set_size(storage, static_cast<size_type>(target - first));
+                        ECS_RETHROW;
+                }
+
+                flush(last);
+
+                auto n = static_cast<size_type>(last - target);
+                set_size(storage, static_cast<size_type>(target - first));
+                return n;
+        }
+
+        template <bool E = is_trivially_relocatable, std::enable_if_t<!E, int> = 0,
+                  typename Predicate>
+        static constexpr size_type erase_if(storage_type& storage, Predicate pred)
+        {
+                auto first = begin(storage), last = end(storage), target = first;
+
+                for(auto i = first; i != last; ++i)
+                {
+                        if(pred(i))
+                                continue;
+
+                        if(target != i)
+                                *target = std::move(*i);
+
+                        ++target;
+                }
+
+                auto n = static_cast<size_type>(last - target);
+                for_each_iter(target, last, [&storage](auto i) { destroy(storage, i); });
+
+                set_size(storage, static_cast<size_type>(target - first));
+                return n;
+        }
+
+        // insertion (storage must have enough capacity):
+        template <bool E = is_trivially_relocatable, std::enable_if_t<E, int> = 0,
+                  typename ForwardIterator>
+        static ECS_CONSTEXPR20 void insert(storage_type& storage, pointer position, size_type n,
+                                           ForwardIterator first)
+        {
+                // relocate elements bytewise, then construct new elements in the gap
+                auto last = end(storage);
+                auto sentinel = position + static_cast<difference_type>(n);
+
+                relocate(storage, position, last, sentinel);
+                first = track_relocation_(first, position, last, static_cast<difference_type>(n));
+
+                ECS_TRY
+                {
+                        uninitialized_copy(storage, position, n, first);
+                }
+                ECS_CATCH(...)
+                {
+                        relocate(storage, sentinel, last + static_cast<difference_type>(n),
+                                 position);
+                        ECS_RETHROW;
+                }
+
+                inc_size(storage, n);
+        }
+
+        template <bool E = is_trivially_relocatable, std::enable_if_t<!E, int> = 0,
+                  typename ForwardIterator>
+        static constexpr void insert(storage_type& storage, pointer position, size_type n,
+                                     ForwardIterator first)
+        {
+                // relocate elements
+                auto k = static_cast<difference_type>(n);
+                auto m = std::min(k, end(storage) - position);
+                auto last = end(storage), first_to_relocate = last - m,
+                     first_to_construct = position + m;
+
+                if(m != k)
+                {
+                        auto mid = first;
+                        std::advance(mid, m);
+
+                        for_each_iter(first_to_construct, position + k, [&storage, &mid](auto i) {
+                                construct(storage, i, *mid), inc_size(storage), ++mid;
+                        });
+                }
+
+                for_each_iter(first_to_relocate, last, first_to_relocate + k,
+                              [&storage](auto i, auto j) {
+                                      construct(storage, j, std::move(*i)), inc_size(storage);
+                              });
+
+                std::move_backward(position, first_to_relocate, last);
+                for_each_iter(position, first_to_construct, first, [](auto i, auto j) { *i = *j; });
+        }
+
+        // insertion and erasure, which shift elements toward the front of double-ended storage,
+        // if the given position is closer to it, and its front capacity suffices (returns false,
+        // if elements must be shifted toward the back instead):
+        template <bool E = is_double_ended, std::enable_if_t<E, int> = 0,
+                  typename ForwardIterator>
+        static ECS_CONSTEXPR20 bool insert_front(storage_type& storage, pointer& position,
+                                                 size_type n, ForwardIterator first)
+        {
+                auto first_element = begin(storage);
+                if(front_capacity(storage) < n ||
+                   position - first_element > end(storage) - position)
+                        return false;
+
+                shift_insert_front_(storage, position, n, first);
+                position -= static_cast<difference_type>(n);
+
+                return true;
+        }
+
+        template <bool E = is_double_ended, std::enable_if_t<!E, int> = 0,
+                  typename ForwardIterator>
+        static constexpr bool insert_front(storage_type&, pointer&, size_type,
+                                           ForwardIterator) noexcept
+        {
+                return false;
+        }
+
+        template <bool E = is_double_ended, std::enable_if_t<E, int> = 0>
+        static constexpr bool erase_front(storage_type& storage, pointer position, size_type n)
+        {
+                auto first_element = begin(storage);
+                auto last = position + static_cast<difference_type>(n);
+
+                if(position - first_element >= end(storage) - last)
+                        return false;
+
+                shift_erase_front_(storage, position, last);
+                shrink_front(storage, n);
+
+                return true;
+        }
+
+        template <bool E = is_double_ended, std::enable_if_t<!E, int> = 0>
+        static constexpr bool erase_front(storage_type&, pointer, size_type) noexcept
+        {
+                return false;
+        }
+
+private:
+        // reallocates storage, then inserts n elements from the given range:
+        template <typename ForwardIterator>
+        static constexpr bool reallocate_insert_(storage_type& storage, pointer position,
+                                                 size_type n, ForwardIterator first,
+                                                 std::false_type)
+        {
+                auto index = position - begin(storage);
+                if(!reallocate(storage, size(storage) + n))
+                        return false;
+
+                insert(storage, begin(storage) + index, n, first);
+                return true;
+        }
+
+        template <typename ForwardIterator>
+        static constexpr bool reallocate_insert_(storage_type& storage, pointer position,
+                                                 size_type n, ForwardIterator first,
+                                                 std::true_type)
+        {
+                if /*constexpr*/ (!meta::reallocate_exists)
+                        return false;
+
+                value_type x(*first);
+                return reallocate_insert_(storage, position, n,
+                                          make_identity_iterator(std::addressof(x)),
+                                          std::false_type{});
+        }
+
+        // shifts elements, which precede the given position, by n toward the front, and
+        // initializes n elements before the position from the given range (elements are
+        // relocated bytewise):
+        template <bool E = is_trivially_relocatable, std::enable_if_t<E, int> = 0,
+                  typename ForwardIterator>
+        static ECS_CONSTEXPR20 void shift_insert_front_(storage_type& storage, pointer position,
+                                                        size_type n, ForwardIterator first)
+        {
+                auto first_element = begin(storage);
+                auto k = static_cast<difference_type>(n);
+
+                relocate(storage, first_element, position, first_element - k);
+                first = track_relocation_(first, first_element, position, -k);
+
+                grow_front(storage, n);
+
+                ECS_TRY
+                {
+                        uninitialized_copy(storage, position - k, n, first);
+                }
+                ECS_CATCH(...)
+                {
+                        relocate(storage, first_element - k, position - k, first_element);
+                        shrink_front(storage, n);
+                        ECS_RETHROW;
+                }
+        }
+
+        // (elements are moved: the ones, which land in front capacity, are move-constructed, the
+        // rest are move-assigned, like in insertion, which shifts elements toward the back)
+        template <bool E = is_trivially_relocatable, std::enable_if_t<!E, int> = 0,
+                  typename ForwardIterator>
+        static ECS_CONSTEXPR20 void shift_insert_front_(storage_type& storage, pointer position,
+                                                        size_type n, ForwardIterator first)
+        {
+                auto first_element = begin(storage);
+                auto k = static_cast<difference_type>(n);
+                auto m = position - first_element;
+
+                if(m >= k)
+                {
+                        uninitialized_copy(storage, first_element - k, n,
+                                           std::make_move_iterator(first_element));
+                        grow_front(storage, n);
+
+                        std::move(first_element + k, position, first_element);
+                        first = track_relocation_(first, first_element, position, -k);
+
+                        for_each_iter(position - k, position, first, [](auto i, auto j) {
+                                *i = *j;
+                        });
+
+                        return;
+                }
+
+                // new elements, which land in front capacity, are constructed first (the given
+                // range is read before the elements it might refer to are moved)
+                auto mid = uninitialized_copy(
+                        storage, position - k, static_cast<size_type>(k - m), first);
+
+                ECS_TRY
+                {
+                        uninitialized_copy(storage, first_element - k,
+                                           static_cast<size_type>(m),
+                                           std::make_move_iterator(first_element));
+                }
+                ECS_CATCH(...)
+                {
+                        for_each_iter(position - k, first_element,
+                                      [&storage](auto i) { destroy(storage, i); });
+                        ECS_RETHROW;
+                }
+
+                grow_front(storage, n);
+
+                mid = track_relocation_(mid, first_element, position, -k);
+                for_each_iter(first_element, position, mid, [](auto i, auto j) { *i = *j; });
+        }
+
+        // shifts elements, which precede the given range, toward the back, so they overwrite the
+        // range, and destroys elements, which are left before them (storage must shrink its front
+        // afterwards):
+        template <bool E = is_trivially_relocatable, std::enable_if_t<E, int> = 0>
+        static constexpr void shift_erase_front_(storage_type& storage, pointer first,
+                                                 pointer last) noexcept
+        {
+                auto first_element = begin(storage);
+
+                for_each_iter(first, last, [&storage](auto i) { destroy(storage, i); });
+                relocate(storage, first_element, first, first_element + (last - first));
+        }
+
+        template <bool E = is_trivially_relocatable, std::enable_if_t<!E, int> = 0>
+        static constexpr void shift_erase_front_(storage_type& storage, pointer first,
+                                                 pointer last)
+        {
+                auto first_element = begin(storage);
+                auto new_first = std::move_backward(first_element, first, last);
+
+                for_each_iter(first_element, new_first,
+                              [&storage](auto i) { destroy(storage, i); });
+        }
+
+        // adjusts iterator, which repeats an element, relocated by the given offset from the
+        // given range:
+        template <typename Iterator>
+        static constexpr identity_iterator<Iterator>
+        track_relocation_(identity_iterator<Iterator> i, pointer first, pointer last,
+                          difference_type n) noexcept
+        {
+                auto p = std::addressof(*i);
+
+                // unrelated pointers can only be compared for equality at compile time
+                if(detail::is_constant_evaluated())
+                {
+                        for(; first != last; ++first)
+                                if(ptr_cast(first) == p)
+                                        return make_identity_iterator(p + n);
+
+                        return i;
+                }
+
+                if(std::less_equal<decltype(p)>{}(ptr_cast(first), p) &&
+                   std::less<decltype(p)>{}(p, ptr_cast(last)))
+                        return make_identity_iterator(p + n);
+
+                return i;
+        }
+
+        template <typename Iterator>
+        static constexpr Iterator track_relocation_(Iterator i, pointer, pointer,
+                                                    difference_type) noexcept
+        {
+                return i;
+        }
 };
 
 //
@@ -12,8 +12,46 @@
 #include <iterator>
 
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <utility>
 #include <memory>
+#include <new>
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// attribute for functions, which implement rarely executed paths (such functions are never
+// inlined, and are placed apart from hot code):
+#if defined(__GNUC__)
+#define ECS_COLD __attribute__((noinline, cold))
+#else
+#define ECS_COLD
+#endif
+
+// constexpr specifier for functions, which can be evaluated at compile time only since C++20
+// (e.g. destructors, and functions, which contain try blocks):
+#if __cpp_constexpr >= 201907L
+#define ECS_CONSTEXPR20 constexpr
+#else
+#define ECS_CONSTEXPR20
+#endif
+
+// exception handling, which degrades gracefully when exceptions are disabled (try blocks are
+// always executed, handlers are never executed, and throwing aborts the program):
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#define ECS_EXCEPTIONS 1
+#define ECS_TRY try
+#define ECS_CATCH(x) catch(x)
+#define ECS_RETHROW throw
+#else
+#define ECS_EXCEPTIONS 0
+#define ECS_TRY if(true)
+#define ECS_CATCH(x) else if(false)
+#define ECS_RETHROW (void)0
+#endif
 
 namespace ecs
 {
@@ -43,6 +81,73 @@ constexpr auto for_each_iter(Countable first, Countable last, Rest&&... rest)
         return zip;
 }
 
+// error policies (storages either throw exceptions, when they fail to obtain memory, or report
+// such failures by returning false from their reallocation functions):
+struct throwing_errors
+{
+};
+
+struct returning_errors
+{
+};
+
+#if ECS_EXCEPTIONS
+using default_error_policy = throwing_errors;
+#else
+using default_error_policy = returning_errors;
+#endif
+
+// allocator, which returns null pointer instead of throwing, when it fails to allocate memory
+// (storages, which use it, report allocation failures through return values):
+template <typename T>
+struct nothrow_allocator
+{
+        // types:
+        using value_type = T;
+        using error_policy = returning_errors;
+
+        // construct:
+        nothrow_allocator() noexcept = default;
+
+        template <typename U>
+        nothrow_allocator(const nothrow_allocator<U>&) noexcept
+        {
+        }
+
+        // allocation/deallocation:
+        T* allocate(std::size_t n) noexcept
+        {
+                if(n > static_cast<std::size_t>(-1) / sizeof(T))
+                        return nullptr;
+
+                if /*constexpr*/ (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                        return static_cast<T*>(::operator new(
+                                n * sizeof(T), std::align_val_t{alignof(T)}, std::nothrow));
+
+                return static_cast<T*>(::operator new(n * sizeof(T), std::nothrow));
+        }
+
+        void deallocate(T* p, std::size_t) noexcept
+        {
+                if /*constexpr*/ (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+                        ::operator delete(p, std::align_val_t{alignof(T)});
+                else
+                        ::operator delete(p);
+        }
+};
+
+template <typename T, typename U>
+constexpr bool operator==(const nothrow_allocator<T>&, const nothrow_allocator<U>&) noexcept
+{
+        return true;
+}
+
+template <typename T, typename U>
+constexpr bool operator!=(const nothrow_allocator<T>&, const nothrow_allocator<U>&) noexcept
+{
+        return false;
+}
+
 // identity iterator:
 template <typename Iterator>
 struct identity_iterator
@@ -73,6 +178,11 @@ struct identity_iterator
                 return std::addressof(operator*());
         }
 
+        constexpr iterator_type base() const
+        {
+                return base_;
+        }
+
         //
         constexpr identity_iterator& operator++() noexcept
         {
@@ -105,6 +215,277 @@ constexpr identity_iterator<Iterator> make_identity_iterator(Iterator i)
         return identity_iterator<Iterator>{i};
 }
 
+template <typename Iterator>
+struct is_identity_iterator : std::false_type
+{
+};
+
+template <typename Iterator>
+struct is_identity_iterator<identity_iterator<Iterator>> : std::true_type
+{
+};
+
+namespace detail
+{
+// returns true during constant evaluation (bytewise algorithms can't be used at compile time,
+// so they fall back to element-wise ones):
+constexpr bool is_constant_evaluated() noexcept
+{
+#if defined(__cpp_lib_is_constant_evaluated)
+        return std::is_constant_evaluated();
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+        return __builtin_is_constant_evaluated();
+#else
+        return false;
+#endif
+#else
+        return false;
+#endif
+}
+
+// throws exception of the given type, or aborts the program, if exceptions are disabled:
+template <typename Exception, typename... Args>
+[[noreturn]] ECS_COLD void throw_exception(Args&&... args)
+{
+#if ECS_EXCEPTIONS
+        throw Exception(std::forward<Args>(args)...);
+#else
+        ((void)args, ...);
+        std::abort();
+#endif
+}
+
+// size of the block, which is broadcast by fill:
+constexpr std::size_t fill_block_size = 32;
+
+template <typename T>
+void broadcast_fill(T* first, std::size_t n, const T& x, std::false_type) noexcept
+{
+        std::fill_n(first, n, x);
+}
+
+template <typename T>
+void broadcast_fill(T* first, std::size_t n, const T& x, std::true_type) noexcept
+{
+        alignas(fill_block_size) unsigned char block[fill_block_size];
+        for(std::size_t i = 0; i < fill_block_size; i += sizeof(T))
+                std::memcpy(block + i, std::addressof(x), sizeof(T));
+
+        auto target = reinterpret_cast<unsigned char*>(first);
+        auto bytes = n * sizeof(T);
+
+        // align target to the block size, so stores do not cross cache lines
+        auto head = (fill_block_size - reinterpret_cast<std::uintptr_t>(target) % fill_block_size) %
+                    fill_block_size;
+        if(head % sizeof(T) == 0 && head < bytes)
+        {
+                std::memcpy(target, block, head);
+                target += head, bytes -= head;
+        }
+
+#if defined(__AVX__)
+        auto v = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+        for(; bytes >= 32; bytes -= 32, target += 32)
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(target), v);
+#elif defined(__SSE2__)
+        // both halves of the block are stored, since an element might span them
+        auto v0 = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+        auto v1 = _mm_load_si128(reinterpret_cast<const __m128i*>(block + 16));
+        for(; bytes >= 32; bytes -= 32, target += 32)
+        {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(target), v0);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(target + 16), v1);
+        }
+#else
+        for(; bytes >= fill_block_size; bytes -= fill_block_size, target += fill_block_size)
+                std::memcpy(target, block, fill_block_size);
+#endif
+
+        // remainder is a prefix of the block
+        std::memcpy(target, block, bytes);
+}
+
+// fills memory with n copies of the given object of trivially copyable type (byte patterns are
+// filled with memset, other patterns, which tile the block, are broadcast with vector stores,
+// if target supports them):
+template <typename T>
+void broadcast_fill(T* first, std::size_t n, const T& x) noexcept
+{
+        static_assert(std::is_trivially_copyable<T>::value);
+
+        if(n == 0)
+                return;
+
+        auto bytes = reinterpret_cast<const unsigned char*>(std::addressof(x));
+        if(std::all_of(bytes, bytes + sizeof(T), [bytes](auto b) { return b == bytes[0]; }))
+        {
+                std::memset(static_cast<void*>(first), bytes[0], n * sizeof(T));
+                return;
+        }
+
+        broadcast_fill(first, n, x,
+                       std::integral_constant<bool, fill_block_size % sizeof(T) == 0>{});
+}
+
+// returns number of trailing zero bits of nonzero value:
+inline unsigned count_trailing_zeros(unsigned x) noexcept
+{
+#if defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctz(x));
+#else
+        unsigned n = 0;
+        for(; (x & 1u) == 0; x >>= 1)
+                ++n;
+
+        return n;
+#endif
+}
+
+// returns index of the first differing byte of two memory regions of the given size (or the
+// size, if regions are equal):
+inline std::size_t mismatch_bytes(const void* lhs, const void* rhs, std::size_t n) noexcept
+{
+        auto x = static_cast<const unsigned char*>(lhs);
+        auto y = static_cast<const unsigned char*>(rhs);
+        std::size_t i = 0;
+
+#if defined(__AVX2__)
+        for(; i + 32 <= n; i += 32)
+        {
+                auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+                auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(y + i));
+
+                auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+                if(mask != 0xFFFFFFFFu)
+                        return i + count_trailing_zeros(~mask);
+        }
+#elif defined(__SSE2__)
+        for(; i + 16 <= n; i += 16)
+        {
+                auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+                auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y + i));
+
+                auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+                if(mask != 0xFFFFu)
+                        return i + count_trailing_zeros(~mask & 0xFFFFu);
+        }
+#endif
+
+        while(i < n && x[i] == y[i])
+                ++i;
+
+        return i;
+}
+
+// element-wise counterparts of bytewise operations for constant evaluation (only objects of
+// trivial types can be stored at compile time, overloads for other types are never called):
+template <typename T>
+constexpr bool is_constant_storable =
+        std::is_trivial<T>::value && std::is_copy_assignable<T>::value;
+
+template <typename T, typename InputIterator,
+          std::enable_if_t<is_constant_storable<T>, int> = 0>
+constexpr void copy_elements(T* target, std::size_t n, InputIterator first)
+{
+        // the source range either doesn't overlap the target, or starts after its beginning
+        for(; n > 0; --n, ++target, (void)++first)
+                *target = *first;
+}
+
+template <typename T, typename InputIterator,
+          std::enable_if_t<!is_constant_storable<T>, int> = 0>
+constexpr void copy_elements(T*, std::size_t, InputIterator) noexcept
+{
+}
+
+template <typename T, std::enable_if_t<is_constant_storable<T>, int> = 0>
+constexpr void move_elements(T* first, T* last, T* d_first)
+{
+        if(d_first < first)
+                for(; first != last; ++first, ++d_first)
+                        *d_first = *first;
+        else
+                for(d_first += last - first; first != last;)
+                        *--d_first = *--last;
+}
+
+template <typename T, std::enable_if_t<!is_constant_storable<T>, int> = 0>
+constexpr void move_elements(T*, T*, T*) noexcept
+{
+}
+
+template <typename T, std::enable_if_t<is_constant_storable<T>, int> = 0>
+constexpr void fill_elements(T* first, std::size_t n, const T& x)
+{
+        for(; n > 0; --n, ++first)
+                *first = x;
+}
+
+template <typename T, std::enable_if_t<!is_constant_storable<T>, int> = 0>
+constexpr void fill_elements(T*, std::size_t, const T&) noexcept
+{
+}
+
+//
+} // namespace detail
+
+// trivially relocatable type trait (can be specialized for types, whose objects can be moved
+// to another location by copying their bytes, provided that the source is not destroyed):
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <typename T, typename D>
+struct is_trivially_relocatable<std::unique_ptr<T, D>> : is_trivially_relocatable<D>
+{
+};
+
+// bytewise equality comparable type trait (can be specialized for types, whose objects are
+// equal if and only if their object representations are equal):
+template <typename T>
+struct is_bytewise_equality_comparable
+        : std::integral_constant<bool, std::is_integral<T>::value || std::is_enum<T>::value ||
+                                               std::is_pointer<T>::value>
+{
+};
+
+// bytewise lexicographically comparable type trait (holds for types, whose ordering matches
+// ordering of their bytes compared as unsigned chars):
+template <typename T>
+struct is_bytewise_lexicographically_comparable
+        : std::integral_constant<bool, std::is_same<T, unsigned char>::value ||
+                                               std::is_same<T, std::byte>::value ||
+                                               (std::is_same<T, char>::value &&
+                                                std::is_unsigned<char>::value)>
+{
+};
+
+// contiguous iterator trait (can be specialized for iterators, which refer to elements stored
+// contiguously in memory, and which can be converted to pointers with to_address):
+template <typename Iterator>
+struct is_contiguous_iterator : std::is_pointer<Iterator>
+{
+};
+
+template <typename Iterator>
+struct is_contiguous_iterator<std::move_iterator<Iterator>> : is_contiguous_iterator<Iterator>
+{
+};
+
+template <typename T>
+constexpr T* to_address(T* ptr) noexcept
+{
+        return ptr;
+}
+
+template <typename Iterator>
+constexpr auto to_address(std::move_iterator<Iterator> i) noexcept
+{
+        return to_address(i.base());
+}
+
 // input iterator concept check:
 template <typename InputIterator>
 using check_input_iterator = std::enable_if_t<!std::is_integral<InputIterator>::value>;
@@ -0,0 +1,1675 @@
+// Copyright Ildus Nezametdinov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#include "contiguous_container_tests.h"
+#include <iterator>
+#include <numeric>
+#include <sstream>
+#include <string>
+
+namespace common_storage_types_testing
+{
+// helper functions:
+template <typename Container>
+bool is_embedded(const Container& c)
+{
+        auto first = reinterpret_cast<const unsigned char*>(std::addressof(c));
+        auto location = reinterpret_cast<const unsigned char*>(c.data());
+
+        return std::less_equal<const unsigned char*>{}(first, location) &&
+               std::less<const unsigned char*>{}(location, first + sizeof(c));
+}
+
+template <typename Container>
+bool check_container(const Container& c, std::initializer_list<std::string> il)
+{
+        return std::equal(c.begin(), c.end(), il.begin(), il.end());
+}
+
+TEST_CASE("small_vector", "[ecs::small_vector]")
+{
+        using container = ecs::small_vector<std::string, 4>;
+
+        // strings are long enough to be allocated on the heap
+        std::string s0(32, 'a'), s1(32, 'b'), s2(32, 'c'), s3(32, 'd'), s4(32, 'e');
+
+        container c;
+
+        REQUIRE(c.empty());
+        REQUIRE(c.capacity() == 4);
+        REQUIRE(is_embedded(c));
+
+        SECTION("elements spill into allocated memory:")
+        {
+                c.push_back(s0);
+                c.push_back(s1);
+                c.push_back(s2);
+                c.push_back(s3);
+
+                REQUIRE(c.full());
+                REQUIRE(c.capacity() == 4);
+                REQUIRE(is_embedded(c));
+
+                auto p = c.push_back(s4);
+                REQUIRE(p != c.end());
+                REQUIRE(*p == s4);
+
+                REQUIRE(c.capacity() >= 5);
+                REQUIRE(!is_embedded(c));
+                REQUIRE(check_container(c, {s0, s1, s2, s3, s4}));
+
+                c.insert(c.begin() + 1, {s4, s4});
+                REQUIRE(check_container(c, {s0, s4, s4, s1, s2, s3, s4}));
+
+                c.erase(c.begin() + 1, c.begin() + 3);
+                REQUIRE(check_container(c, {s0, s1, s2, s3, s4}));
+        }
+
+        SECTION("move construct and move assign:")
+        {
+                c.assign({s0, s1, s2});
+
+                // embedded elements are relocated
+                container x{std::move(c)};
+                REQUIRE(is_embedded(x));
+                REQUIRE(check_container(x, {s0, s1, s2}));
+                REQUIRE(c.empty());
+
+                // allocated memory is stolen
+                x.assign({s0, s1, s2, s3, s4});
+                auto data = x.data();
+
+                container y{std::move(x)};
+                REQUIRE(y.data() == data);
+                REQUIRE(check_container(y, {s0, s1, s2, s3, s4}));
+
+                REQUIRE(x.empty());
+                REQUIRE(x.capacity() == 4);
+                REQUIRE(is_embedded(x));
+
+                //
+                x.assign({s3, s4});
+                y = std::move(x);
+                REQUIRE(y.data() == data);
+                REQUIRE(check_container(y, {s3, s4}));
+                REQUIRE(x.empty());
+
+                x.assign({s0, s1, s2, s3, s4});
+                data = x.data();
+
+                y = std::move(x);
+                REQUIRE(y.data() == data);
+                REQUIRE(check_container(y, {s0, s1, s2, s3, s4}));
+                REQUIRE(is_embedded(x));
+        }
+
+        SECTION("copy construct and copy assign:")
+        {
+                c.assign({s0, s1, s2, s3, s4});
+
+                container x{c};
+                REQUIRE(x == c);
+
+                container y{s0};
+                REQUIRE(is_embedded(y));
+
+                y = c;
+                REQUIRE(y == c);
+
+                c = container{s1, s2};
+                REQUIRE(check_container(c, {s1, s2}));
+        }
+
+        SECTION("swap:")
+        {
+                container x{s0, s1}, y{s2, s3, s4};
+
+                x.swap(y);
+                REQUIRE(check_container(x, {s2, s3, s4}));
+                REQUIRE(check_container(y, {s0, s1}));
+
+                c.assign({s0, s1, s2, s3, s4});
+                auto data = c.data();
+
+                c.swap(x);
+                REQUIRE(x.data() == data);
+                REQUIRE(is_embedded(c));
+                REQUIRE(check_container(c, {s2, s3, s4}));
+                REQUIRE(check_container(x, {s0, s1, s2, s3, s4}));
+
+                y.assign({s4, s3, s2, s1, s0});
+                x.swap(y);
+                REQUIRE(check_container(x, {s4, s3, s2, s1, s0}));
+                REQUIRE(check_container(y, {s0, s1, s2, s3, s4}));
+        }
+}
+
+TEST_CASE("trivially relocatable elements", "[ecs::is_trivially_relocatable]")
+{
+        using element = std::unique_ptr<int>;
+
+        static_assert(ecs::is_trivially_relocatable<int>::value);
+        static_assert(ecs::is_trivially_relocatable<element>::value);
+        static_assert(!ecs::is_trivially_relocatable<std::string>::value);
+
+        static_assert(ecs::vector<element>::traits::is_trivially_relocatable);
+        static_assert(ecs::small_vector<element, 2>::traits::is_trivially_relocatable);
+        static_assert(ecs::inplace_vector<int, 2>::traits::is_trivially_relocatable);
+        static_assert(!ecs::vector<std::string>::traits::is_trivially_relocatable);
+
+        auto values = [](const auto& c) {
+                std::vector<int> r;
+                for(auto& x : c)
+                        r.push_back(*x);
+
+                return r;
+        };
+
+        ecs::vector<element> c;
+        for(int i = 0; i < 5; ++i)
+                c.push_back(std::make_unique<int>(i));
+
+        REQUIRE(values(c) == (std::vector<int>{0, 1, 2, 3, 4}));
+
+        c.reserve(c.capacity() + 1);
+        REQUIRE(values(c) == (std::vector<int>{0, 1, 2, 3, 4}));
+
+        c.emplace(c.begin() + 2, std::make_unique<int>(10));
+        REQUIRE(values(c) == (std::vector<int>{0, 1, 10, 2, 3, 4}));
+
+        c.erase(c.begin(), c.begin() + 2);
+        REQUIRE(values(c) == (std::vector<int>{10, 2, 3, 4}));
+
+        c.erase(c.end() - 1);
+        REQUIRE(values(c) == (std::vector<int>{10, 2, 3}));
+
+        //
+        ecs::small_vector<element, 2> x, y;
+        x.push_back(std::make_unique<int>(1));
+        x.push_back(std::make_unique<int>(2));
+
+        y = std::move(x);
+        REQUIRE(x.empty());
+        REQUIRE(values(y) == (std::vector<int>{1, 2}));
+
+        y.emplace(y.begin(), std::make_unique<int>(0));
+        REQUIRE(values(y) == (std::vector<int>{0, 1, 2}));
+
+        //
+        ecs::inplace_vector<int, 8> z{1, 2, 3};
+        z.insert(z.begin() + 1, 3, 7);
+        REQUIRE(std::vector<int>(z.begin(), z.end()) == (std::vector<int>{1, 7, 7, 7, 2, 3}));
+
+        z.erase(z.begin(), z.begin() + 2);
+        REQUIRE(std::vector<int>(z.begin(), z.end()) == (std::vector<int>{7, 7, 2, 3}));
+}
+
+// type, which counts move constructions:
+struct move_counter
+{
+        move_counter(int x_) : x{x_}
+        {
+        }
+
+        move_counter(const move_counter& other) : x{other.x}
+        {
+        }
+
+        move_counter(move_counter&& other) noexcept : x{other.x}
+        {
+                ++n_moves;
+        }
+
+        move_counter& operator=(const move_counter&) = default;
+        move_counter& operator=(move_counter&&) = default;
+
+        ~move_counter()
+        {
+        }
+
+        int x;
+        static int n_moves;
+};
+
+int move_counter::n_moves{};
+
+TEST_CASE("growing insert relocates each element once", "[ecs::vector]")
+{
+        auto values = [](const auto& c) {
+                std::vector<int> r;
+                for(auto& i : c)
+                        r.push_back(i.x);
+
+                return r;
+        };
+
+        ecs::vector<move_counter> c;
+        ecs::small_vector<move_counter, 4> x;
+
+        for(int i = 0; i < 4; ++i)
+                c.emplace_back(i), x.emplace_back(i);
+
+        c.reserve(4);
+        REQUIRE(c.full());
+        REQUIRE(x.full());
+
+        int v[] = {10, 11};
+
+        move_counter::n_moves = 0;
+        c.insert(c.begin() + 1, std::begin(v), std::end(v));
+        REQUIRE(move_counter::n_moves == 4);
+        REQUIRE(values(c) == (std::vector<int>{0, 10, 11, 1, 2, 3}));
+
+        move_counter::n_moves = 0;
+        x.insert(x.begin() + 1, std::begin(v), std::end(v));
+        REQUIRE(move_counter::n_moves == 4);
+        REQUIRE(values(x) == (std::vector<int>{0, 10, 11, 1, 2, 3}));
+
+        // inserted value might refer to an element of the container
+        while(!c.full())
+                c.emplace_back(0);
+
+        c.insert(c.begin(), 2, c.back());
+        REQUIRE(c[0].x == c.back().x);
+        REQUIRE(c[1].x == c.back().x);
+}
+
+TEST_CASE("growing emplace_back constructs new element first", "[ecs::vector]")
+{
+        // strings are long enough to be allocated on the heap
+        std::string s0(32, 'a'), s1(32, 'b');
+
+        ecs::vector<std::string> c;
+        ecs::small_vector<std::string, 2> x;
+
+        c.push_back(s0);
+        c.reserve(1);
+        x.push_back(s0), x.push_back(s1);
+
+        REQUIRE(c.full());
+        REQUIRE(x.full());
+
+        // new element refers to an element, which is relocated during growth
+        auto p = c.push_back(c[0]);
+        REQUIRE(p == c.end() - 1);
+        REQUIRE(check_container(c, {s0, s0}));
+
+        for(int i = 0; i < 8; ++i)
+                c.push_back(c.back());
+        REQUIRE(c.size() == 10);
+        REQUIRE(std::all_of(c.begin(), c.end(), [&s0](auto& s) { return s == s0; }));
+
+        p = x.emplace_back(x[1]);
+        REQUIRE(p == x.end() - 1);
+        REQUIRE(check_container(x, {s0, s1, s1}));
+
+}
+
+// allocator, which customizes default construction of elements
+struct constructing_allocator : std::allocator<int>
+{
+        template <typename U>
+        struct rebind
+        {
+                using other = constructing_allocator;
+        };
+
+        void construct(int* p)
+        {
+                ::new((void*)p) int{7};
+        }
+};
+
+TEST_CASE("default-initializing resize", "[ecs::vector]")
+{
+        static_assert(ecs::vector<unsigned char>::traits::is_trivially_default_constructible);
+        static_assert(!ecs::vector<std::string>::traits::is_trivially_default_constructible);
+        static_assert(!ecs::vector<int, constructing_allocator>::traits::
+                              is_trivially_default_constructible);
+
+        ecs::vector<unsigned char> c;
+
+        REQUIRE(c.resize_default_init(100));
+        REQUIRE(c.size() == 100);
+        REQUIRE(c.capacity() >= 100);
+
+        std::fill(c.begin(), c.end(), 1);
+        REQUIRE(c.resize_default_init(10));
+        REQUIRE(c.size() == 10);
+
+        auto p = c.reserve_and_append_uninitialized(20);
+        REQUIRE(p == c.begin() + 10);
+        REQUIRE(c.size() == 30);
+        REQUIRE(std::all_of(c.begin(), p, [](auto x) { return x == 1; }));
+
+        p = c.reserve_and_append_uninitialized(c.max_size());
+        REQUIRE(p == c.end());
+        REQUIRE(c.size() == 30);
+
+        // elements of non-trivial types are still constructed
+        ecs::vector<std::string> x{std::string(32, 'a')};
+
+        REQUIRE(x.resize_default_init(3));
+        REQUIRE(check_container(x, {std::string(32, 'a'), "", ""}));
+
+        auto q = x.reserve_and_append_uninitialized(2);
+        REQUIRE(q == x.begin() + 3);
+        REQUIRE(check_container(x, {std::string(32, 'a'), "", "", "", ""}));
+
+        // allocator customizes construction
+        ecs::vector<int, constructing_allocator> y;
+
+        REQUIRE(y.resize_default_init(3));
+        REQUIRE(std::all_of(y.begin(), y.end(), [](auto i) { return i == 7; }));
+}
+
+TEST_CASE("writing into spare capacity", "[contiguous_container]")
+{
+        // writes up to 3 elements
+        auto writer = [](auto first, auto max_n) {
+                decltype(max_n) n = 0;
+                for(; n < max_n && n < 3; ++n)
+                        *first++ = static_cast<int>(n + 1);
+
+                return n;
+        };
+
+        auto check = [](auto& c, std::initializer_list<int> il) {
+                return std::equal(c.begin(), c.end(), il.begin(), il.end());
+        };
+
+        SECTION("bounded capacity:")
+        {
+                ecs::inplace_vector<int, 4> c;
+
+                REQUIRE(c.append_with(2, writer));
+                REQUIRE(check(c, {1, 2}));
+
+                REQUIRE(!c.append_with(3, writer));
+                REQUIRE(check(c, {1, 2}));
+
+                REQUIRE(c.append_with(2, [](auto, auto) { return 0; }));
+                REQUIRE(check(c, {1, 2}));
+
+                REQUIRE(c.append_with(2, writer));
+                REQUIRE(check(c, {1, 2, 1, 2}));
+        }
+
+        SECTION("growing capacity:")
+        {
+                ecs::vector<int> c{7};
+
+                REQUIRE(c.append_with(100, writer));
+                REQUIRE(c.capacity() >= 101);
+                REQUIRE(check(c, {7, 1, 2, 3}));
+
+                REQUIRE(!c.append_with(c.max_size(), writer));
+                REQUIRE(check(c, {7, 1, 2, 3}));
+
+                // size does not change if writer throws
+                REQUIRE_THROWS(c.append_with(1000, [](auto first, auto) -> std::size_t {
+                        *first = 0;
+                        throw 0;
+                }));
+
+                REQUIRE(c.capacity() >= 1004);
+                REQUIRE(check(c, {7, 1, 2, 3}));
+        }
+}
+
+TEST_CASE("bytewise copying of trivially copyable elements", "[ecs::vector]")
+{
+        using traits = ecs::vector<int>::traits;
+
+        static_assert(traits::is_bytewise_copyable_from<int*>);
+        static_assert(traits::is_bytewise_copyable_from<const int*>);
+        static_assert(traits::is_bytewise_copyable_from<std::move_iterator<int*>>);
+        static_assert(!traits::is_bytewise_copyable_from<const long*>);
+        static_assert(!traits::is_bytewise_copyable_from<std::istream_iterator<int>>);
+        static_assert(!ecs::vector<std::string>::traits::is_bytewise_copyable_from<std::string*>);
+        static_assert(!ecs::vector<int, constructing_allocator>::traits::
+                              is_bytewise_copyable_from<int*>);
+
+        auto check = [](auto& c, std::initializer_list<int> il) {
+                return std::equal(c.begin(), c.end(), il.begin(), il.end());
+        };
+
+        ecs::vector<int> c{1, 2, 3, 4, 5};
+
+        SECTION("copy construct and assign:")
+        {
+                auto x = c;
+                REQUIRE(check(x, {1, 2, 3, 4, 5}));
+
+                ecs::inplace_vector<int, 8> y{1, 2, 3}, z{y};
+                REQUIRE(check(z, {1, 2, 3}));
+
+                z = std::move(y);
+                REQUIRE(check(z, {1, 2, 3}));
+                REQUIRE(y.empty());
+
+                int v[] = {7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+                x.assign(std::begin(v), std::begin(v) + 2);
+                REQUIRE(check(x, {7, 8}));
+
+                x.assign(std::begin(v), std::end(v));
+                REQUIRE(check(x, {7, 8, 9, 10, 11, 12, 13, 14, 15, 16}));
+
+                // source range overlaps with elements of the container
+                x.assign(x.begin() + 7, x.end());
+                REQUIRE(check(x, {14, 15, 16}));
+        }
+
+        SECTION("range insert:")
+        {
+                int v[] = {10, 11};
+
+                c.reserve(16);
+                c.insert(c.begin() + 1, std::begin(v), std::end(v));
+                REQUIRE(check(c, {1, 10, 11, 2, 3, 4, 5}));
+
+                c.insert(c.end(), std::begin(v), std::end(v));
+                REQUIRE(check(c, {1, 10, 11, 2, 3, 4, 5, 10, 11}));
+
+                ecs::vector<int> x{1, 2};
+                x.insert(x.begin() + 1, c.begin(), c.end());
+                REQUIRE(check(x, {1, 1, 10, 11, 2, 3, 4, 5, 10, 11, 2}));
+        }
+}
+
+template <std::size_t N>
+struct pattern
+{
+        unsigned char data[N];
+
+        bool operator==(const pattern& other) const
+        {
+                return std::equal(std::begin(data), std::end(data), std::begin(other.data));
+        }
+};
+
+template <std::size_t N>
+void check_broadcast_fill()
+{
+        pattern<N> x{}, y{};
+        for(std::size_t i = 0; i < N; ++i)
+                x.data[i] = static_cast<unsigned char>(i + 1), y.data[i] = 0xAB;
+
+        auto is_filled = [](auto& c, auto& v) {
+                return std::all_of(c.begin(), c.end(), [&v](auto& e) { return e == v; });
+        };
+
+        for(std::size_t n : {1, 2, 3, 15, 16, 17, 33, 100, 1001})
+        {
+                ecs::vector<pattern<N>> c;
+
+                REQUIRE(c.resize(n, x));
+                REQUIRE(c.size() == n);
+                REQUIRE(is_filled(c, x));
+
+                REQUIRE(c.assign(n + 1, y));
+                REQUIRE(c.size() == n + 1);
+                REQUIRE(is_filled(c, y));
+
+                REQUIRE(c.assign(n / 2, x));
+                REQUIRE(c.size() == n / 2);
+                REQUIRE(is_filled(c, x));
+
+                auto p = c.insert(c.end(), n, x);
+                REQUIRE(p == c.begin() + static_cast<std::ptrdiff_t>(n / 2));
+                REQUIRE(c.size() == n / 2 + n);
+                REQUIRE(is_filled(c, x));
+        }
+}
+
+TEST_CASE("broadcast fill", "[ecs::vector]")
+{
+        static_assert(ecs::vector<int>::traits::is_bytewise_fillable_from<
+                      ecs::identity_iterator<const int*>>);
+        static_assert(!ecs::vector<std::string>::traits::is_bytewise_fillable_from<
+                      ecs::identity_iterator<const std::string*>>);
+
+        check_broadcast_fill<1>();
+        check_broadcast_fill<2>();
+        check_broadcast_fill<4>();
+        check_broadcast_fill<8>();
+        check_broadcast_fill<12>();
+        check_broadcast_fill<16>();
+        check_broadcast_fill<32>();
+        check_broadcast_fill<64>();
+
+        // inserted value refers to an element of the container, which is shifted
+        ecs::vector<int> c{1, 2, 3, 4};
+        c.reserve(16);
+
+        c.insert(c.begin() + 1, 3, c[2]);
+        REQUIRE(std::equal(c.begin(), c.end(), std::begin({1, 3, 3, 3, 2, 3, 4})));
+
+        c.insert(c.begin(), 2, c.back());
+        REQUIRE(std::equal(c.begin(), c.end(), std::begin({4, 4, 1, 3, 3, 3, 2, 3, 4})));
+}
+
+TEST_CASE("bytewise comparison", "[contiguous_container]")
+{
+        static_assert(ecs::is_bytewise_equality_comparable<std::uint32_t>::value);
+        static_assert(!ecs::is_bytewise_equality_comparable<float>::value);
+        static_assert(ecs::is_bytewise_lexicographically_comparable<unsigned char>::value);
+        static_assert(!ecs::is_bytewise_lexicographically_comparable<std::uint32_t>::value);
+
+        SECTION("multibyte elements:")
+        {
+                ecs::vector<int> x(100), y(100);
+                std::iota(x.begin(), x.end(), -50), std::iota(y.begin(), y.end(), -50);
+
+                REQUIRE(x == y);
+                REQUIRE(!(x < y));
+                REQUIRE(ecs::mismatch_index(x, y) == 100);
+
+                for(std::size_t i : {0, 1, 7, 8, 31, 32, 33, 63, 64, 99})
+                {
+                        auto z = y;
+                        z[i] = 1000;
+
+                        REQUIRE(x != z);
+                        REQUIRE(ecs::mismatch_index(x, z) == i);
+                        REQUIRE(ecs::mismatch_index(z, x) == i);
+                        REQUIRE(x < z);
+                        REQUIRE(z > x);
+
+                        z[i] = -1000;
+                        REQUIRE(z < x);
+                }
+
+                y.pop_back();
+                REQUIRE(x != y);
+                REQUIRE(ecs::mismatch_index(x, y) == 99);
+                REQUIRE(y < x);
+
+                ecs::vector<int> e;
+                REQUIRE(e < y);
+                REQUIRE(e == ecs::vector<int>{});
+                REQUIRE(ecs::mismatch_index(e, x) == 0);
+        }
+
+        SECTION("bytes:")
+        {
+                ecs::vector<unsigned char> x(70, 1), y(70, 1);
+
+                REQUIRE(x == y);
+                REQUIRE(!(x < y));
+
+                y[40] = 200;
+                REQUIRE(x < y);
+                REQUIRE(ecs::mismatch_index(x, y) == 40);
+
+                x[40] = 255, x.pop_back();
+                REQUIRE(y < x);
+        }
+
+        SECTION("elements compared with operators:")
+        {
+                ecs::vector<std::string> x{"a", "b", "c"}, y{"a", "b", "d"};
+
+                REQUIRE(x != y);
+                REQUIRE(x < y);
+                REQUIRE(ecs::mismatch_index(x, y) == 2);
+        }
+}
+
+TEST_CASE("cross-storage operations", "[contiguous_container]")
+{
+        auto check = [](auto& c, std::initializer_list<int> il) {
+                return std::equal(c.begin(), c.end(), il.begin(), il.end());
+        };
+
+        SECTION("comparison:")
+        {
+                ecs::inplace_vector<int, 8> x{1, 2, 3};
+                ecs::vector<int> y{1, 2, 3};
+                ecs::small_vector<int, 2> z{1, 2, 4};
+
+                REQUIRE(x == y);
+                REQUIRE(y == x);
+                REQUIRE(x != z);
+                REQUIRE(x < z);
+                REQUIRE(z > y);
+                REQUIRE(y <= x);
+                REQUIRE(ecs::mismatch_index(y, z) == 2);
+        }
+
+        SECTION("copy assignment:")
+        {
+                ecs::inplace_vector<int, 4> x{1, 2, 3};
+                ecs::vector<int> y{7};
+
+                REQUIRE(y.assign(x));
+                REQUIRE(check(y, {1, 2, 3}));
+                REQUIRE(check(x, {1, 2, 3}));
+
+                y.push_back(4), y.push_back(5);
+                REQUIRE(!x.assign(y));
+
+                y.pop_back();
+                REQUIRE(x.assign(y));
+                REQUIRE(check(x, {1, 2, 3, 4}));
+        }
+
+        SECTION("move assignment relocates elements:")
+        {
+                ecs::inplace_vector<std::unique_ptr<int>, 4> x;
+                x.push_back(std::make_unique<int>(1)), x.push_back(std::make_unique<int>(2));
+
+                auto p = x[1].get();
+
+                ecs::vector<std::unique_ptr<int>> y;
+                REQUIRE(y.assign(std::move(x)));
+                REQUIRE(x.empty());
+                REQUIRE(y.size() == 2);
+                REQUIRE(*y[0] == 1);
+                REQUIRE(y[1].get() == p);
+
+                // elements are kept, if the source doesn't fit
+                ecs::inplace_vector<int, 4> z{1, 2};
+                ecs::vector<int> w(10, 3);
+
+                REQUIRE(!z.assign(std::move(w)));
+                REQUIRE(check(z, {1, 2}));
+                REQUIRE(w.size() == 10);
+        }
+
+        SECTION("move assignment converts elements of different types:")
+        {
+                ecs::inplace_vector<int, 4> x{1, 2, 3};
+                ecs::vector<long> y{7};
+
+                REQUIRE(y.assign(std::move(x)));
+                REQUIRE(x.empty());
+                REQUIRE((y == ecs::vector<long>{1, 2, 3}));
+
+                ecs::vector<short> z{4, 5};
+                ecs::inplace_vector<int, 4> w;
+
+                REQUIRE(w.assign(std::move(z)));
+                REQUIRE(z.empty());
+                REQUIRE(check(w, {4, 5}));
+        }
+
+        SECTION("move assignment steals memory:")
+        {
+                ecs::vector<int> x{1, 2, 3};
+                ecs::vector<int, std::allocator<int>, ecs::exact_growth> y{4, 5};
+
+                auto p = x.data();
+
+                REQUIRE(y.assign(std::move(x)));
+                REQUIRE(y.data() == p);
+                REQUIRE(check(y, {1, 2, 3}));
+                REQUIRE(x.empty());
+                REQUIRE(x.capacity() == 0);
+
+                REQUIRE(x.assign(std::move(y)));
+                REQUIRE(x.data() == p);
+                REQUIRE(check(x, {1, 2, 3}));
+        }
+
+        SECTION("move assignment moves elements:")
+        {
+                std::string s0(32, 'a'), s1(32, 'b');
+
+                ecs::small_vector<std::string, 1> x{s0, s1};
+                ecs::vector<std::string> y{s1};
+
+                REQUIRE(y.assign(std::move(x)));
+                REQUIRE(x.empty());
+                REQUIRE(check_container(y, {s0, s1}));
+        }
+}
+
+TEST_CASE("batch append", "[contiguous_container]")
+{
+        auto check = [](auto& c, std::initializer_list<int> il) {
+                return std::equal(c.begin(), c.end(), il.begin(), il.end());
+        };
+
+        SECTION("append range:")
+        {
+                int v[] = {1, 2, 3};
+                std::istringstream is{"4 5"};
+
+                ecs::vector<int> c;
+                REQUIRE(c.append(std::begin(v), std::end(v)));
+                REQUIRE(c.append(std::istream_iterator<int>{is}, std::istream_iterator<int>{}));
+                REQUIRE(check(c, {1, 2, 3, 4, 5}));
+
+                ecs::inplace_vector<int, 4> x;
+                REQUIRE(x.append(std::begin(v), std::end(v)));
+                REQUIRE(!x.append(std::begin(v), std::end(v)));
+                REQUIRE(check(x, {1, 2, 3}));
+        }
+
+        SECTION("append generated elements:")
+        {
+                int i = 0;
+                auto gen = [&i] { return ++i; };
+
+                ecs::vector<int> c{0};
+                REQUIRE(c.append_n(4, gen));
+                REQUIRE(check(c, {0, 1, 2, 3, 4}));
+
+                ecs::inplace_vector<int, 4> x;
+                REQUIRE(!x.append_n(5, gen));
+                REQUIRE(x.empty());
+
+                REQUIRE(!c.append_n(c.max_size(), gen));
+                REQUIRE(c.size() == 5);
+
+                // elements are destroyed, if generator throws
+                std::string s(32, 'a');
+                ecs::vector<std::string> y{s};
+
+                REQUIRE_THROWS(y.append_n(10, [&s, k = 0]() mutable {
+                        if(++k == 5)
+                                throw 0;
+
+                        return s;
+                }));
+
+                REQUIRE(check_container(y, {s}));
+        }
+
+        SECTION("unchecked emplace_back:")
+        {
+                ecs::vector<int> c;
+                c.reserve(3);
+
+                for(int i = 1; i <= 3; ++i)
+                        REQUIRE(*c.emplace_back_unchecked(i) == i);
+
+                REQUIRE(check(c, {1, 2, 3}));
+        }
+}
+
+// input iterator, which throws on the third element
+struct throwing_input_iterator
+{
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string*;
+        using reference = std::string;
+
+        std::string operator*() const
+        {
+                if(*n == 3)
+                        throw 0;
+
+                return std::string(32, static_cast<char>('a' + *n));
+        }
+
+        throwing_input_iterator& operator++()
+        {
+                return ++*n, *this;
+        }
+
+        bool operator!=(const throwing_input_iterator& other) const
+        {
+                return *n != *other.n;
+        }
+
+        bool operator==(const throwing_input_iterator& other) const
+        {
+                return *n == *other.n;
+        }
+
+        int* n;
+};
+
+TEST_CASE("insertion from input iterators", "[contiguous_container]")
+{
+        auto check = [](auto& c, std::initializer_list<int> il) {
+                return std::equal(c.begin(), c.end(), il.begin(), il.end());
+        };
+
+        ecs::vector<int> c{1, 2, 3};
+
+        std::istringstream is{"10 11 12 13 14"};
+        auto p = c.insert(
+                c.begin() + 1, std::istream_iterator<int>{is}, std::istream_iterator<int>{});
+
+        REQUIRE(p == c.begin() + 1);
+        REQUIRE(check(c, {1, 10, 11, 12, 13, 14, 2, 3}));
+
+        std::istringstream is1{"20"};
+        p = c.insert(c.begin(), std::istream_iterator<int>{is1}, std::istream_iterator<int>{});
+
+        REQUIRE(p == c.begin());
+        REQUIRE(check(c, {20, 1, 10, 11, 12, 13, 14, 2, 3}));
+
+        // insertion into bounded container stops, when it is full
+        ecs::inplace_vector<int, 4> x{1, 2};
+
+        std::istringstream is2{"10 11 12"};
+        auto q = x.insert(
+                x.begin(), std::istream_iterator<int>{is2}, std::istream_iterator<int>{});
+
+        REQUIRE(q == x.end());
+        REQUIRE(check(x, {10, 11, 1, 2}));
+
+        // elements are rotated in place, or through spare capacity of the storage
+        ecs::inplace_vector<int, 8> z{1, 2, 3, 4, 5};
+
+        std::istringstream is3{"10 11 12"};
+        q = z.insert(z.begin() + 1, std::istream_iterator<int>{is3}, std::istream_iterator<int>{});
+        REQUIRE(q == z.begin() + 1);
+        REQUIRE(check(z, {1, 10, 11, 12, 2, 3, 4, 5}));
+
+        z.resize(4);
+        std::istringstream is4{"20 21"};
+        q = z.insert(z.begin() + 1, std::istream_iterator<int>{is4}, std::istream_iterator<int>{});
+        REQUIRE(q == z.begin() + 1);
+        REQUIRE(check(z, {1, 20, 21, 10, 11, 12}));
+
+        // container is restored, if construction throws
+
+        std::string s0(32, 'x'), s1(32, 'y');
+        ecs::vector<std::string> y{s0, s1};
+
+        int first = 0, last = 5;
+        REQUIRE_THROWS(y.insert(y.begin() + 1, throwing_input_iterator{&first},
+                                 throwing_input_iterator{&last}));
+        REQUIRE(check_container(y, {s0, s1}));
+}
+
+TEST_CASE("unordered and batch erasure", "[contiguous_container]")
+{
+        auto check = [](auto& c, std::initializer_list<int> il) {
+                return std::equal(c.begin(), c.end(), il.begin(), il.end());
+        };
+
+        SECTION("erase_unordered replaces element with the last one:")
+        {
+                ecs::vector<int> c{0, 1, 2, 3, 4};
+
+                auto p = c.erase_unordered(c.begin() + 1);
+                REQUIRE(p == c.begin() + 1);
+                REQUIRE(check(c, {0, 4, 2, 3}));
+
+                p = c.erase_unordered(c.end() - 1);
+                REQUIRE(p == c.end());
+                REQUIRE(check(c, {0, 4, 2}));
+
+                std::string s0(32, 'a'), s1(32, 'b'), s2(32, 'c');
+                ecs::vector<std::string> x{s0, s1, s2};
+
+                x.erase_unordered(x.begin());
+                REQUIRE(check_container(x, {s2, s1}));
+
+                ecs::vector<std::unique_ptr<int>> y;
+                for(int i = 0; i < 3; ++i)
+                        y.emplace_back(std::make_unique<int>(i));
+
+                y.erase_unordered(y.begin());
+                REQUIRE(y.size() == 2);
+                REQUIRE(*y[0] == 2);
+                REQUIRE(*y[1] == 1);
+        }
+
+        SECTION("erase_if compacts elements in a single pass:")
+        {
+                ecs::vector<int> c{0, 1, 2, 3, 4, 5, 6, 7};
+
+                auto n = ecs::erase_if(c, [](int x) { return x % 3 != 0; });
+                REQUIRE(n == 5);
+                REQUIRE(check(c, {0, 3, 6}));
+
+                REQUIRE(ecs::erase_if(c, [](int) { return false; }) == 0);
+                REQUIRE(check(c, {0, 3, 6}));
+
+                std::string s0(32, 'a'), s1(32, 'b'), s2(32, 'c');
+                ecs::small_vector<std::string, 2> x{s0, s1, s2, s1};
+
+                REQUIRE(ecs::erase_if(x, [&](auto& s) { return s == s1; }) == 2);
+                REQUIRE(check_container(x, {s0, s2}));
+
+                ecs::vector<std::unique_ptr<int>> y;
+                for(int i = 0; i < 6; ++i)
+                        y.emplace_back(std::make_unique<int>(i));
+
+                REQUIRE(ecs::erase_if(y, [](auto& p) { return *p < 2 || *p == 4; }) == 3);
+                REQUIRE(y.size() == 3);
+                REQUIRE(*y[0] == 2);
+                REQUIRE(*y[1] == 3);
+                REQUIRE(*y[2] == 5);
+        }
+
+        SECTION("container stays valid, if predicate throws:")
+        {
+                ecs::vector<std::unique_ptr<int>> y;
+                for(int i = 0; i < 6; ++i)
+                        y.emplace_back(std::make_unique<int>(i));
+
+                REQUIRE_THROWS(ecs::erase_if(y, [](auto& p) {
+                        if(*p == 3)
+                                throw std::runtime_error{"predicate"};
+
+                        return *p == 1;
+                }));
+
+                REQUIRE(y.size() == 5);
+                REQUIRE(*y[0] == 0);
+                REQUIRE(*y[1] == 2);
+                REQUIRE(*y[4] == 5);
+        }
+
+        SECTION("erase_indices erases elements at sorted indices:")
+        {
+                ecs::vector<int> c{0, 1, 2, 3, 4, 5, 6, 7};
+
+                REQUIRE(ecs::erase_indices(c, std::initializer_list<int>{0, 3, 4, 7}) == 4);
+                REQUIRE(check(c, {1, 2, 5, 6}));
+
+                REQUIRE(ecs::erase_indices(c, std::vector<std::size_t>{}) == 0);
+                REQUIRE(check(c, {1, 2, 5, 6}));
+
+                std::string s0(32, 'a'), s1(32, 'b'), s2(32, 'c');
+                ecs::vector<std::string> x{s0, s1, s2};
+
+                std::size_t indices[] = {1};
+                REQUIRE(ecs::erase_indices(x, indices) == 1);
+                REQUIRE(check_container(x, {s0, s2}));
+        }
+}
+
+TEST_CASE("shrinking capacity", "[contiguous_container]")
+{
+        SECTION("vector moves elements into smaller buffer:")
+        {
+                ecs::vector<int> c(1000);
+                std::iota(c.begin(), c.end(), 0);
+
+                c.erase(c.begin() + 10, c.end());
+                REQUIRE(c.shrink_to(100));
+                REQUIRE(c.capacity() == 100);
+
+                REQUIRE(c.shrink_to_fit());
+                REQUIRE(c.capacity() == 10);
+
+                std::vector<int> expected(10);
+                std::iota(expected.begin(), expected.end(), 0);
+                REQUIRE(std::equal(c.begin(), c.end(), expected.begin(), expected.end()));
+
+                // capacity is never less than size, and never grows
+                REQUIRE(!c.shrink_to(5));
+                REQUIRE(!c.shrink_to(20));
+                REQUIRE(c.capacity() == 10);
+
+                c.clear();
+                REQUIRE(c.shrink_to_fit());
+                REQUIRE(c.capacity() == 0);
+                REQUIRE(c.data() == nullptr);
+
+                std::string s0(32, 'a'), s1(32, 'b');
+                ecs::vector<std::string> x{s0, s1};
+
+                x.reserve(100);
+                REQUIRE(x.shrink_to_fit());
+                REQUIRE(x.capacity() == 2);
+                REQUIRE(check_container(x, {s0, s1}));
+        }
+
+        SECTION("small_vector moves elements into embedded buffer:")
+        {
+                std::string s0(32, 'a'), s1(32, 'b'), s2(32, 'c');
+                ecs::small_vector<std::string, 2> x{s0, s1, s2};
+
+                x.reserve(100);
+                REQUIRE(x.shrink_to(10));
+                REQUIRE(x.capacity() == 10);
+                REQUIRE(check_container(x, {s0, s1, s2}));
+
+                x.pop_back();
+                REQUIRE(x.shrink_to_fit());
+                REQUIRE(x.capacity() == 2);
+                REQUIRE(is_embedded(x));
+                REQUIRE(check_container(x, {s0, s1}));
+
+                REQUIRE(!x.shrink_to_fit());
+
+                ecs::small_vector<int, 4> y{1, 2, 3, 4, 5};
+                y.pop_back();
+
+                REQUIRE(y.shrink_to_fit());
+                REQUIRE(is_embedded(y));
+                REQUIRE((y == ecs::small_vector<int, 4>{1, 2, 3, 4}));
+        }
+
+        SECTION("inplace_vector can't release memory:")
+        {
+                ecs::inplace_vector<int, 8> c{1, 2};
+
+                REQUIRE(!c.shrink_to_fit());
+                REQUIRE(c.capacity() == 8);
+        }
+}
+
+// allocator, which fails to allocate more than 16 elements (it either throws, or returns null
+// pointer, depending on the error policy):
+template <typename T, typename ErrorPolicy>
+struct limited_allocator : std::allocator<T>
+{
+        using error_policy = ErrorPolicy;
+
+        template <typename U>
+        struct rebind
+        {
+                using other = limited_allocator<U, ErrorPolicy>;
+        };
+
+        limited_allocator() = default;
+
+        template <typename U>
+        limited_allocator(const limited_allocator<U, ErrorPolicy>&) noexcept
+        {
+        }
+
+        T* allocate(std::size_t n)
+        {
+                if(n <= 16)
+                        return std::allocator<T>::allocate(n);
+
+                if /*constexpr*/ (std::is_same<ErrorPolicy, ecs::returning_errors>::value)
+                        return nullptr;
+
+                throw std::bad_alloc{};
+        }
+};
+
+TEST_CASE("error policies", "[contiguous_container]")
+{
+        using throwing_vector = ecs::vector<int, limited_allocator<int, ecs::throwing_errors>>;
+        using returning_vector = ecs::vector<int, limited_allocator<int, ecs::returning_errors>>;
+
+        static_assert(!ecs::vector<int>::traits::reports_errors);
+        static_assert(!throwing_vector::traits::reports_errors);
+        static_assert(returning_vector::traits::reports_errors);
+        static_assert(ecs::vector<int, ecs::nothrow_allocator<int>>::traits::reports_errors);
+        static_assert(ecs::inplace_vector<int, 4>::traits::reports_errors);
+
+        SECTION("throwing storages report failures through try_ functions:")
+        {
+                throwing_vector c(16);
+
+                REQUIRE_THROWS_AS(c.push_back(1), const std::bad_alloc&);
+                REQUIRE_THROWS_AS(c.reserve(c.max_size() + 1), const std::length_error&);
+
+                REQUIRE(c.try_push_back(1) == c.end());
+                REQUIRE(c.try_insert(c.begin(), {1, 2}) == c.end());
+                REQUIRE(c.try_insert(c.begin(), std::size_t{2}, 1) == c.end());
+                REQUIRE(!c.try_reserve(17));
+                REQUIRE(!c.try_reserve(c.max_size() + 1));
+                REQUIRE(c.size() == 16);
+
+                c.pop_back();
+                auto p = c.try_push_back(1);
+                REQUIRE(p == c.end() - 1);
+                REQUIRE(c.try_reserve(16));
+        }
+
+        SECTION("returning storages report failures through return values:")
+        {
+                returning_vector c(16);
+                std::iota(c.begin(), c.end(), 0);
+
+                REQUIRE(c.push_back(1) == c.end());
+                REQUIRE(c.emplace_back(1) == c.end());
+                REQUIRE(c.insert(c.begin(), {1, 2}) == c.end());
+                REQUIRE(!c.reserve(17));
+                REQUIRE(!c.reserve(c.max_size() + 1));
+                REQUIRE(!c.resize(17));
+                REQUIRE(!c.append_n(1, [] { return 0; }));
+                REQUIRE(c.try_push_back(1) == c.end());
+
+                std::vector<int> expected(16);
+                std::iota(expected.begin(), expected.end(), 0);
+                REQUIRE(std::equal(c.begin(), c.end(), expected.begin(), expected.end()));
+
+                ecs::small_vector<std::string, 2,
+                                  limited_allocator<std::string, ecs::returning_errors>>
+                        x;
+                for(int i = 0; i < 16; ++i)
+                        x.emplace_back(32, 'a');
+
+                REQUIRE(x.size() == 16);
+
+                REQUIRE(x.emplace_back(32, 'b') == x.end());
+                REQUIRE(x.size() == 16);
+                REQUIRE(x.back() == std::string(32, 'a'));
+        }
+
+        SECTION("nothrow_allocator returns null pointer:")
+        {
+                ecs::vector<int, ecs::nothrow_allocator<int>> c{1, 2, 3};
+
+                REQUIRE(!c.reserve(c.max_size() + 1));
+                REQUIRE(c.push_back(4) != c.end());
+                REQUIRE((c == ecs::vector<int>{1, 2, 3, 4}));
+        }
+}
+
+// sizes of embedded storages are kept in the smallest suitable unsigned type:
+static_assert(sizeof(ecs::inplace_vector<std::uint8_t, 7>) == 8);
+static_assert(sizeof(ecs::inplace_vector<std::uint8_t, 255>) == 256);
+static_assert(sizeof(ecs::inplace_vector<std::uint16_t, 300>) == 602);
+static_assert(sizeof(ecs::inplace_vector<std::uint32_t, 3>) == 16);
+static_assert(sizeof(ecs::inplace_vector<std::uint64_t, 1>) == 16);
+static_assert(std::is_same<ecs::inplace_vector<std::uint8_t, 7>::size_type, std::size_t>::value);
+
+TEST_CASE("compact size", "[ecs::inplace_vector]")
+{
+        ecs::inplace_vector<std::uint8_t, 255> c;
+        for(int i = 0; i < 300; ++i)
+                c.push_back(static_cast<std::uint8_t>(i));
+
+        REQUIRE(c.size() == 255);
+        REQUIRE(c.full());
+        REQUIRE(c.back() == 254);
+
+        ecs::inplace_vector<std::uint16_t, 300> d(300, 7);
+        REQUIRE(d.size() == 300);
+
+        d.erase(d.begin(), d.begin() + 45);
+        REQUIRE(d.size() == 255);
+        auto i = d.insert(d.end(), 45, 1);
+        REQUIRE(i == d.begin() + 255);
+        REQUIRE(d.size() == 300);
+}
+
+// allocator, which is propagated on copy assignment, and compares equal only to copies of itself:
+template <typename T>
+struct propagating_allocator : std::allocator<T>
+{
+        using propagate_on_container_copy_assignment = std::true_type;
+        using is_always_equal = std::false_type;
+
+        template <typename U>
+        struct rebind
+        {
+                using other = propagating_allocator<U>;
+        };
+
+        explicit propagating_allocator(int i = 0) noexcept : id{i}
+        {
+        }
+
+        template <typename U>
+        propagating_allocator(const propagating_allocator<U>& other) noexcept : id{other.id}
+        {
+        }
+
+        bool operator==(const propagating_allocator& other) const noexcept
+        {
+                return id == other.id;
+        }
+
+        bool operator!=(const propagating_allocator& other) const noexcept
+        {
+                return id != other.id;
+        }
+
+        int id;
+};
+
+// type, which throws, when the element with the given value is moved:
+struct throwing_move
+{
+        throwing_move(int x_) : x{x_}
+        {
+        }
+
+        throwing_move(const throwing_move&) = default;
+        throwing_move(throwing_move&& other) : x{other.x}
+        {
+                if(x == 2)
+                        throw 0;
+        }
+
+        throwing_move& operator=(const throwing_move&) = default;
+        throwing_move& operator=(throwing_move&&) = default;
+
+        int x;
+};
+
+TEST_CASE("move construction with unequal allocator", "[contiguous_container]")
+{
+        using allocator = propagating_allocator<throwing_move>;
+
+        SECTION("vector frees memory on exception:")
+        {
+                ecs::vector<throwing_move, allocator> x(allocator{1});
+                x.emplace_back(1), x.emplace_back(2);
+
+                auto move = [&x] {
+                        ecs::vector<throwing_move, allocator> y{std::move(x), allocator{2}};
+                };
+
+                REQUIRE_THROWS(move());
+        }
+
+        SECTION("small_vector frees memory on exception:")
+        {
+                using container = ecs::small_vector<throwing_move, 1, allocator>;
+
+                container x(allocator{1});
+                x.emplace_back(1), x.emplace_back(2);
+
+                auto move = [&x] { container y{std::move(x), allocator{2}}; };
+                REQUIRE_THROWS(move());
+        }
+}
+
+TEST_CASE("fixed_vector", "[ecs::fixed_vector]")
+{
+        using container = ecs::fixed_vector<std::string>;
+        std::string s0(32, 'a'), s1(32, 'b'), s2(32, 'c');
+
+        // construction from a size creates elements, like with other containers
+        REQUIRE(container(2).size() == 2);
+        REQUIRE(container(2).capacity() == 2);
+        REQUIRE(check_container(container(2, s0), {s0, s0}));
+
+        container c(ecs::with_capacity, 3);
+        REQUIRE(c.empty());
+        REQUIRE(c.capacity() == 3);
+
+        SECTION("capacity is allocated once, overflow is reported through return values:")
+        {
+                auto data = c.data();
+
+                c.push_back(s0);
+                c.insert(c.begin(), {s1, s2});
+                REQUIRE(c.full());
+                REQUIRE(c.data() == data);
+
+                REQUIRE(c.push_back(s0) == c.end());
+                REQUIRE(c.insert(c.begin(), s0) == c.end());
+                REQUIRE(!c.reserve(4));
+                REQUIRE(!c.resize(4));
+                REQUIRE(!c.shrink_to_fit());
+
+                REQUIRE(c.data() == data);
+                REQUIRE(check_container(c, {s1, s2, s0}));
+
+                c.erase(c.begin());
+                auto p = c.push_back(s1);
+                REQUIRE(p == c.begin() + 2);
+                REQUIRE(check_container(c, {s2, s0, s1}));
+        }
+
+        SECTION("copy, move and swap:")
+        {
+                c.assign({s0, s1});
+
+                container x{c};
+                REQUIRE(x.capacity() == 3);
+                REQUIRE(check_container(x, {s0, s1}));
+
+                container y(ecs::with_capacity, 1);
+                REQUIRE_THROWS_AS(y = x, const std::bad_alloc&);
+
+                y = std::move(x);
+                REQUIRE(y.capacity() == 3);
+                REQUIRE(x.capacity() == 0);
+                REQUIRE(check_container(y, {s0, s1}));
+
+                container z;
+                REQUIRE(z.full());
+                REQUIRE(z.push_back(s0) == z.end());
+
+                z.swap(y);
+                REQUIRE(y.capacity() == 0);
+                REQUIRE(check_container(z, {s0, s1}));
+        }
+
+        SECTION("copy assignment propagates allocator:")
+        {
+                using allocator = propagating_allocator<std::string>;
+
+                ecs::fixed_vector<std::string, allocator> x(ecs::with_capacity, 3, allocator{1});
+                ecs::fixed_vector<std::string, allocator> y(ecs::with_capacity, 4, allocator{2});
+
+                x.assign({s0, s1});
+                y.push_back(s2);
+
+                y = x;
+                REQUIRE(y.get_allocator() == x.get_allocator());
+                REQUIRE(y.capacity() == 4);
+                REQUIRE(check_container(y, {s0, s1}));
+        }
+}
+
+TEST_CASE("thin_vector", "[ecs::thin_vector]")
+{
+        using container = ecs::thin_vector<std::string>;
+        std::string s0(32, 'a'), s1(32, 'b'), s2(32, 'c');
+
+        static_assert(sizeof(container) == sizeof(void*));
+
+        container c;
+        REQUIRE(c.empty());
+        REQUIRE(c.full());
+        REQUIRE(c.capacity() == 0);
+        REQUIRE(c.data() == nullptr);
+
+        SECTION("size and capacity are kept in the heap block:")
+        {
+                c.push_back(s0);
+                REQUIRE(c.data() != nullptr);
+                REQUIRE(c.capacity() >= 1);
+
+                c.insert(c.begin(), {s1, s2});
+                c.emplace_back(s1);
+                REQUIRE(check_container(c, {s1, s2, s0, s1}));
+
+                c.erase(c.begin() + 1);
+                REQUIRE(check_container(c, {s1, s0, s1}));
+
+                container x{c};
+                REQUIRE(x == c);
+
+                container y{std::move(x)};
+                REQUIRE(x.data() == nullptr);
+                REQUIRE(y == c);
+
+                x = y;
+                y.clear();
+                REQUIRE(y.empty());
+                REQUIRE(y.data() != nullptr);
+
+                REQUIRE(y.shrink_to_fit());
+                REQUIRE(y.data() == nullptr);
+                REQUIRE(check_container(x, {s1, s0, s1}));
+
+                x.swap(y);
+                REQUIRE(x.empty());
+                REQUIRE(check_container(y, {s1, s0, s1}));
+        }
+
+        SECTION("elements are aligned after the header:")
+        {
+                struct alignas(32) aligned
+                {
+                        char x;
+                };
+
+                ecs::thin_vector<aligned> x(3);
+                REQUIRE(reinterpret_cast<std::uintptr_t>(x.data()) % 32 == 0);
+
+                ecs::thin_vector<char> y(100, 'a');
+                y.resize(1000, 'b');
+                REQUIRE(y.size() == 1000);
+                REQUIRE(std::count(y.begin(), y.end(), 'a') == 100);
+        }
+
+        SECTION("move construction with unequal allocator frees memory on exception:")
+        {
+                using allocator = propagating_allocator<throwing_move>;
+
+                ecs::thin_vector<throwing_move, allocator> x(allocator{1});
+                x.emplace_back(1), x.emplace_back(2);
+
+                auto move = [&x] {
+                        ecs::thin_vector<throwing_move, allocator> y{std::move(x), allocator{2}};
+                };
+
+                REQUIRE_THROWS(move());
+        }
+
+        SECTION("storage reports errors through return values with nothrow_allocator:")
+        {
+                ecs::thin_vector<int, ecs::nothrow_allocator<int>> x{1, 2, 3};
+
+                REQUIRE(!x.reserve(x.max_size() + 1));
+                REQUIRE(x.push_back(4) != x.end());
+                REQUIRE((x == ecs::vector<int>{1, 2, 3, 4}));
+        }
+}
+
+TEST_CASE("devector", "[ecs::devector]")
+{
+        SECTION("elements are added and removed at both ends:")
+        {
+                ecs::devector<int> c;
+                REQUIRE(c.empty());
+
+                for(int i = 0; i < 100; ++i)
+                {
+                        c.push_back(i);
+                        c.push_front(-i - 1);
+                }
+
+                REQUIRE(c.size() == 200);
+                REQUIRE(c.front() == -100);
+                REQUIRE(c.back() == 99);
+                REQUIRE(std::is_sorted(c.begin(), c.end()));
+
+                c.pop_front();
+                c.pop_back();
+                REQUIRE(c.front() == -99);
+                REQUIRE(c.back() == 98);
+
+                auto i = c.emplace_front(-1000);
+                REQUIRE(i == c.begin());
+                REQUIRE(c.front() == -1000);
+                REQUIRE(c.size() == 199);
+        }
+
+        SECTION("sliding window doesn't grow the buffer:")
+        {
+                ecs::devector<int> c;
+                for(int i = 0; i < 16; ++i)
+                        c.push_back(i);
+
+                auto capacity = c.capacity() + static_cast<std::size_t>(c.data() - &c.front());
+                for(int i = 16; i < 10000; ++i)
+                {
+                        c.pop_front();
+                        c.push_back(i);
+
+                        REQUIRE(c.front() == i - 15);
+                }
+
+                REQUIRE(c.size() == 16);
+                REQUIRE(c.back() == 9999);
+                REQUIRE(c.capacity() <= 2 * capacity);
+        }
+
+        SECTION("insertion and erasure shift elements toward the closer end:")
+        {
+                ecs::devector<int> c;
+                for(int i = 0; i < 10; ++i)
+                        c.push_back(i);
+
+                c.reserve(c.size() + 10);
+                auto i = c.erase(c.begin());
+                REQUIRE(i == c.begin());
+
+                auto last = c.end();
+                i = c.erase(c.begin() + 1, c.begin() + 3);
+                REQUIRE(i == c.begin() + 1);
+                REQUIRE(c.end() == last);
+                REQUIRE((c == ecs::vector<int>{1, 4, 5, 6, 7, 8, 9}));
+
+                auto first = c.data();
+                i = c.insert(c.begin() + 1, 2, c[0]);
+                REQUIRE(i == c.begin() + 1);
+                REQUIRE(c.data() == first - 2);
+                REQUIRE((c == ecs::vector<int>{1, 1, 1, 4, 5, 6, 7, 8, 9}));
+
+                i = c.insert(c.begin() + 7, {10, 11});
+                REQUIRE(i == c.begin() + 7);
+                REQUIRE((c == ecs::vector<int>{1, 1, 1, 4, 5, 6, 7, 10, 11, 8, 9}));
+        }
+
+        SECTION("elements which are not trivially relocatable:")
+        {
+                std::string s0(32, 'a'), s1(32, 'b'), s2(32, 'c');
+                ecs::devector<std::string> c;
+
+                c.push_front(s0);
+                c.push_back(s1);
+                c.emplace_front(s2);
+                c.push_front(c.back());
+                REQUIRE(check_container(c, {s1, s2, s0, s1}));
+
+                c.insert(c.begin() + 1, 2, c[0]);
+                c.erase(c.begin() + 4);
+                REQUIRE(check_container(c, {s1, s1, s1, s2, s1}));
+
+                ecs::devector<std::string> x{c};
+                x.pop_front();
+                x.pop_front();
+                REQUIRE(check_container(x, {s1, s2, s1}));
+
+                c = std::move(x);
+                REQUIRE(check_container(c, {s1, s2, s1}));
+                REQUIRE(c.shrink_to_fit());
+                REQUIRE(c.capacity() == 3);
+        }
+
+        SECTION("elements which are not trivially relocatable are shifted toward the front:")
+        {
+                std::string s[10];
+                ecs::devector<std::string> c;
+                for(int i = 0; i < 10; ++i)
+                        c.push_back(s[i] = std::string(32, static_cast<char>('a' + i)));
+
+                c.reserve(c.size() + 10);
+                c.erase(c.begin());
+
+                auto last = c.end();
+                auto i = c.erase(c.begin() + 1, c.begin() + 3);
+                REQUIRE(i == c.begin() + 1);
+                REQUIRE(c.end() == last);
+                REQUIRE(check_container(c, {s[1], s[4], s[5], s[6], s[7], s[8], s[9]}));
+
+                // new elements partially land in front capacity
+                auto first = c.data();
+                i = c.insert(c.begin() + 1, 2, c[0]);
+                REQUIRE(i == c.begin() + 1);
+                REQUIRE(c.data() == first - 2);
+                REQUIRE(check_container(c, {s[1], s[1], s[1], s[4], s[5], s[6], s[7], s[8], s[9]}));
+
+                // new elements are move-assigned
+                first = c.data();
+                c[1] = s[2];
+                i = c.insert(c.begin() + 3, c[1]);
+                REQUIRE(i == c.begin() + 3);
+                REQUIRE(c.data() == first - 1);
+                REQUIRE(check_container(
+                        c, {s[1], s[2], s[1], s[2], s[4], s[5], s[6], s[7], s[8], s[9]}));
+        }
+
+        SECTION("move construction with unequal allocator frees memory on exception:")
+        {
+                using allocator = propagating_allocator<throwing_move>;
+
+                ecs::devector<throwing_move, allocator> x(allocator{1});
+                x.reserve(2);
+                x.emplace_back(1), x.emplace_back(2);
+
+                auto move = [&x] {
+                        ecs::devector<throwing_move, allocator> y{std::move(x), allocator{2}};
+                };
+
+                REQUIRE_THROWS(move());
+        }
+}
+
+#if __cpp_constexpr >= 201907L
+// compile-time construction of containers (elements of trivial types):
+constexpr ecs::inplace_vector<int, 16> make_sorted_table(std::initializer_list<int> il)
+{
+        ecs::inplace_vector<int, 16> c;
+
+        for(auto x : il)
+                c.insert(std::upper_bound(c.begin(), c.end(), x), x);
+
+        return c;
+}
+
+constexpr ecs::inplace_vector<unsigned, 32> make_prime_table()
+{
+        ecs::inplace_vector<unsigned, 32> c(32);
+
+        for(unsigned i = 0; i < 32; ++i)
+                c[i] = i;
+
+        erase_if(c, [](unsigned x) {
+                for(unsigned d = 2; d * d <= x; ++d)
+                        if(x % d == 0)
+                                return true;
+
+                return x < 2;
+        });
+
+        return c;
+}
+
+constexpr auto edit_table()
+{
+        auto c = make_sorted_table({5, 3, 8, 1});
+
+        c.insert(c.begin(), 2, c[3]);
+        c.erase(c.begin() + 2);
+        c.emplace_back(4);
+        c.erase_unordered(c.begin());
+
+        auto d = c;
+        d.resize(2);
+        d.insert(d.end(), 3, 9);
+        d.swap(c);
+
+        return std::make_pair(c, d);
+}
+
+constexpr auto insert_streamed()
+{
+        auto c = make_sorted_table({1, 2, 3});
+        int a[] = {7, 8};
+
+        c.insert(c.begin() + 1, contiguous_container_testing::make_input_iterator(a),
+                 contiguous_container_testing::make_input_iterator(a + 2));
+
+        return c;
+}
+
+constexpr auto sorted_table = make_sorted_table({5, 3, 8, 1, 9, 2});
+constexpr auto prime_table = make_prime_table();
+constexpr auto edited_tables = edit_table();
+
+static_assert(sorted_table.size() == 6 && sorted_table.front() == 1 && sorted_table.back() == 9);
+static_assert(sorted_table == make_sorted_table({1, 2, 3, 5, 8, 9}));
+static_assert(sorted_table < make_sorted_table({1, 2, 4}));
+static_assert(insert_streamed().size() == 5 && insert_streamed()[1] == 7 &&
+              insert_streamed()[2] == 8 && insert_streamed()[3] == 2);
+static_assert(prime_table.size() == 11 && prime_table[4] == 11 && prime_table.back() == 31);
+static_assert(edited_tables.first == make_sorted_table({4, 8, 9, 9, 9}));
+static_assert(edited_tables.second.size() == 5 && edited_tables.second[0] == 4 &&
+              edited_tables.second[2] == 3 && edited_tables.second[4] == 8);
+
+TEST_CASE("constant evaluation", "[ecs::inplace_vector]")
+{
+        // tables, which are built at run time, must be equal to the ones built at compile time
+        auto c = make_prime_table();
+        REQUIRE(c == prime_table);
+
+        auto tables = edit_table();
+        REQUIRE(tables.first == edited_tables.first);
+        REQUIRE(tables.second == edited_tables.second);
+}
+#endif
+
+//
+} // namespace common_storage_types_testing
@@ -563,23 +563,25 @@ TEST_CASE("core container functionality", "[contiguous_container]")
                 REQUIRE(c.size() == 3);
                 REQUIRE(check_container(c, {{1, 2, 3}}));
 
-                // construct(ids): 3, 4 move from 2
-                // move(ids): 1 -> 2, 3 -> 1
-                // destroy(ids): 3
-                // construct(ids): 5, 6 move from 4
-                // move(ids): 2 -> 4, 5 -> 2
+                // elements are appended, then rotated into place:
+                // construct(ids): 3, 4
+                // construct(ids): 5 move from 1
+                // move(ids): 3 -> 1, 5 -> 3
                 // destroy(ids): 5
+                // construct(ids): 6 move from 2
+                // move(ids): 4 -> 2, 6 -> 4
+                // destroy(ids): 6
                 int v[] = {11, 12};
 
                 auto p = c.insert(c.begin() + 1, make_input_iterator(std::begin(v)),
                                   make_input_iterator(std::end(v)));
                 REQUIRE(p->x == 11);
 
-                // identifiers: 0, 1, 2, 4, 6
+                // identifiers: 0, 1, 2, 3, 4
                 REQUIRE(c.size() == 5);
                 REQUIRE(check_container(c, {{1, 11, 12, 2, 3}}));
 
-                // destroy(ids): 0, 1, 2, 4, 6
+                // destroy(ids): 0, 1, 2, 3, 4
                 c.clear();
 
                 //
@@ -588,20 +590,20 @@ TEST_CASE("core container functionality", "[contiguous_container]")
                          log_entry{log_entry::op_type::non_default_construct, 1, 1},
                          log_entry{log_entry::op_type::non_default_construct, 2, 2},
                          log_entry{log_entry::op_type::non_default_construct, 3, 3},
-                         log_entry{log_entry::op_type::move_construct, 2, 4},
-                         log_entry{log_entry::op_type::move, 1, 2},
+                         log_entry{log_entry::op_type::non_default_construct, 4, 4},
+                         log_entry{log_entry::op_type::move_construct, 1, 5},
                          log_entry{log_entry::op_type::move, 3, 1},
-                         log_entry{log_entry::op_type::destroy, 3, 3},
-                         log_entry{log_entry::op_type::non_default_construct, 5, 5},
-                         log_entry{log_entry::op_type::move_construct, 4, 6},
-                         log_entry{log_entry::op_type::move, 2, 4},
-                         log_entry{log_entry::op_type::move, 5, 2},
+                         log_entry{log_entry::op_type::move, 5, 3},
                          log_entry{log_entry::op_type::destroy, 5, 5},
+                         log_entry{log_entry::op_type::move_construct, 2, 6},
+                         log_entry{log_entry::op_type::move, 4, 2},
+                         log_entry{log_entry::op_type::move, 6, 4},
+                         log_entry{log_entry::op_type::destroy, 6, 6},
                          log_entry{log_entry::op_type::destroy, 0, 0},
                          log_entry{log_entry::op_type::destroy, 1, 1},
                          log_entry{log_entry::op_type::destroy, 2, 2},
-                         log_entry{log_entry::op_type::destroy, 4, 4},
-                         log_entry{log_entry::op_type::destroy, 6, 6}}}));
+                         log_entry{log_entry::op_type::destroy, 3, 3},
+                         log_entry{log_entry::op_type::destroy, 4, 4}}}));
 
                 REQUIRE(c.n_construct_calls == 5);
                 REQUIRE(c.n_destroy_calls == 5);
@@ -0,0 +1,151 @@
+// Copyright Ildus Nezametdinov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#include "mapped_storage_types_tests.h"
+#include "../source/ecs/gap_buffer.h"
+
+namespace gap_buffer_testing
+{
+template <typename T>
+bool check_gap_buffer(const ecs::gap_buffer<T>& c, std::initializer_list<T> il)
+{
+        if(c.size() != il.size())
+                return false;
+
+        std::size_t i = 0;
+        for(auto& x : il)
+                if(!(c[i++] == x))
+                        return false;
+
+        return true;
+}
+
+TEST_CASE("gap_buffer", "[ecs::gap_buffer]")
+{
+        SECTION("edits near the gap don't move it:")
+        {
+                ecs::gap_buffer<char> c;
+                REQUIRE(c.empty());
+
+                for(char x : {'h', 'e', 'l', 'o'})
+                {
+                        auto i = c.insert(c.size(), x);
+                        REQUIRE(i == c.size() - 1);
+                }
+
+                REQUIRE(c.gap_position() == 4);
+                REQUIRE(c.erase(3));
+                REQUIRE(c.gap_position() == 3);
+
+                REQUIRE(c.insert(3, 2, 'l') == 3);
+                REQUIRE(c.erase(4));
+                REQUIRE(c.insert(4, 'o') == 4);
+                REQUIRE(c.gap_position() == 5);
+                REQUIRE(check_gap_buffer(c, {'h', 'e', 'l', 'l', 'o'}));
+        }
+
+        SECTION("the gap moves lazily to the edited position:")
+        {
+                ecs::gap_buffer<int> c{1, 2, 3, 4, 5, 6};
+                REQUIRE(c.gap_position() == 6);
+
+                REQUIRE(c.insert(2, 10) == 2);
+                REQUIRE(c.gap_position() == 3);
+                REQUIRE(check_gap_buffer(c, {1, 2, 10, 3, 4, 5, 6}));
+
+                REQUIRE(c.insert(3, 11) == 3);
+                REQUIRE(c.erase(5, 2));
+                REQUIRE(c.gap_position() == 5);
+                REQUIRE(check_gap_buffer(c, {1, 2, 10, 11, 3, 6}));
+
+                REQUIRE(c.erase(0));
+                REQUIRE(c.gap_position() == 0);
+                REQUIRE(c.front() == 2);
+                REQUIRE(c.back() == 6);
+
+                REQUIRE(c.insert(4, {7, 8}) == 4);
+                REQUIRE(check_gap_buffer(c, {2, 10, 11, 3, 7, 8, 6}));
+
+                // arguments might refer to elements, which are moved along with the gap
+                REQUIRE(c.insert(1, c[5]) == 1);
+                REQUIRE(c.insert(7, 2, c[0]) == 7);
+                REQUIRE(check_gap_buffer(c, {2, 8, 10, 11, 3, 7, 8, 2, 2, 6}));
+        }
+
+        SECTION("contiguous view closes the gap:")
+        {
+                ecs::gap_buffer<int> c{1, 2, 3};
+                c.insert(1, {4, 5});
+                c.insert(0, 6);
+
+                auto v = c.contiguous_view();
+                REQUIRE(v != nullptr);
+                REQUIRE(c.gap_position() == c.size());
+                REQUIRE((*v == ecs::vector<int>{6, 1, 4, 5, 2, 3}));
+                REQUIRE(v->data() == &c[0]);
+
+                v->push_back(7);
+                REQUIRE(c.size() == 7);
+                REQUIRE(c.back() == 7);
+        }
+
+        SECTION("contiguous view reports failure to close the gap:")
+        {
+                using allocator = common_storage_types_testing::limited_allocator<
+                        int, ecs::returning_errors>;
+                ecs::gap_buffer<int, allocator> c;
+
+                int a[16] = {};
+                REQUIRE(c.insert(0, std::begin(a), std::end(a)) == 0);
+                REQUIRE(c.insert(0, 1) == 0);
+                REQUIRE(c.gap_position() == 1);
+
+                // elements don't fit in the vector before the gap
+                REQUIRE(c.contiguous_view() == nullptr);
+                REQUIRE(c.size() == 17);
+                REQUIRE(c.gap_position() == 1);
+                REQUIRE(c.front() == 1);
+        }
+
+        SECTION("elements which are not trivially relocatable:")
+        {
+                std::string s0(32, 'a'), s1(32, 'b'), s2(32, 'c');
+                ecs::gap_buffer<std::string> c{s0, s1, s2};
+
+                c.insert(1, s2);
+                c.insert(0, 2, s1);
+                c.erase(3, 2);
+                REQUIRE(check_gap_buffer(c, {s1, s1, s0, s2}));
+
+                auto x = c;
+                x.erase(0, x.size());
+                REQUIRE(x.empty());
+
+                x.swap(c);
+                REQUIRE(c.empty());
+                REQUIRE(x == ecs::gap_buffer<std::string>({s1, s1, s0, s2}));
+                REQUIRE(x.contiguous_view()->size() == 4);
+        }
+
+        SECTION("edits at the gap don't shift elements after it:")
+        {
+                std::string s0(32, 'a'), s1(32, 'b');
+                ecs::gap_buffer<std::string> c{s0, s0, s0, s0, s0, s0};
+
+                REQUIRE(c.insert(2, s1) == 2);
+                REQUIRE(c.gap_position() == 3);
+
+                auto last = &c.back();
+                REQUIRE(c.erase(3, 2));
+                REQUIRE(c.insert(3, 2, s1) == 3);
+                REQUIRE(c.erase(4));
+                REQUIRE(c.gap_position() == 4);
+
+                REQUIRE(&c.back() == last);
+                REQUIRE(check_gap_buffer(c, {s0, s0, s1, s1, s0, s0}));
+        }
+}
+
+//
+} // namespace gap_buffer_testing
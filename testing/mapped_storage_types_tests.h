@@ -0,0 +1,223 @@
+// Copyright Ildus Nezametdinov 2017.
+// Distributed under the Boost Software License, Version 1.0.
+//(See accompanying file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+#include "common_storage_types_tests.h"
+#include "../source/ecs/mapped_storage_types.h"
+
+#include <cstdio>
+
+namespace mapped_storage_types_testing
+{
+struct record
+{
+        int id;
+        double value;
+};
+
+TEST_CASE("mmap_vector", "[ecs::mmap_vector]")
+{
+        const char* path = "mmap_vector_test.bin";
+        std::remove(path);
+
+        {
+                ecs::mmap_vector<record> c{path};
+                REQUIRE(c.empty());
+                REQUIRE(c.capacity() > 0);
+
+                for(int i = 0; i < 10000; ++i)
+                {
+                        auto p = c.push_back(record{i, i * 0.5});
+                        REQUIRE(p != c.end());
+                }
+
+                REQUIRE(c.size() == 10000);
+
+                c.erase(c.begin(), c.begin() + 5000);
+                REQUIRE(c.size() == 5000);
+                REQUIRE(c.front().id == 5000);
+
+                c.sync();
+        }
+
+        {
+                // elements are restored from the file
+                ecs::mmap_vector<record> c{path};
+                REQUIRE(c.size() == 5000);
+
+                for(int i = 0; i < 5000; ++i)
+                {
+                        REQUIRE(c[static_cast<std::size_t>(i)].id == i + 5000);
+                        REQUIRE(c[static_cast<std::size_t>(i)].value == Approx((i + 5000) * 0.5));
+                }
+
+                ecs::mmap_vector<record> x{std::move(c)};
+                REQUIRE(x.size() == 5000);
+
+                // moved-from container is empty, and can't grow
+                REQUIRE(c.empty());
+                REQUIRE(c.size() == 0);
+                REQUIRE(c.capacity() == 0);
+                REQUIRE(c.begin() == c.end());
+                c.clear();
+                REQUIRE(c.push_back(record{1, 1.0}) == c.end());
+
+                x.clear();
+        }
+
+        {
+                ecs::mmap_vector<record> c{path};
+                REQUIRE(c.empty());
+
+                // file with different element type is rejected
+                REQUIRE_THROWS(ecs::mmap_vector<char>{path});
+        }
+
+        {
+                // element of a full container is pushed back
+                ecs::mmap_vector<record> c{path};
+                while(c.size() != c.capacity())
+                        c.push_back(record{static_cast<int>(c.size()), 1.0});
+
+                auto n = c.size();
+                REQUIRE(c.push_back(c[0]) != c.end());
+                REQUIRE(c.size() == n + 1);
+                REQUIRE(c.back().id == 0);
+                c.clear();
+        }
+
+        std::remove(path);
+}
+
+TEST_CASE("stable_vector", "[ecs::stable_vector]")
+{
+        static_assert(ecs::stable_vector<std::string>::traits::reports_errors);
+
+        ecs::stable_vector<std::string> c{100000};
+
+        REQUIRE(c.empty());
+        REQUIRE(c.capacity() == 0);
+        REQUIRE(c.max_size() == 100000);
+
+        c.emplace_back(std::string(32, 'a'));
+        auto data = c.data();
+
+        // elements are never relocated
+        for(std::size_t i = 1; i < c.max_size(); ++i)
+                c.emplace_back(std::string(32, 'b'));
+
+        REQUIRE(c.data() == data);
+        REQUIRE(c.size() == c.max_size());
+        REQUIRE(c.front() == std::string(32, 'a'));
+
+        // capacity can't exceed reservation
+        REQUIRE(c.emplace_back() == c.end());
+        REQUIRE(!c.reserve(c.max_size() + 1));
+
+        c.erase(c.begin() + 1, c.end());
+        c.insert(c.begin(), std::string(32, 'c'));
+        REQUIRE(c.data() == data);
+
+        // unused pages are decommitted in place
+        REQUIRE(c.shrink_to_fit());
+        REQUIRE(c.data() == data);
+        REQUIRE(c.capacity() < 1000);
+        REQUIRE(c.capacity() >= c.size());
+        REQUIRE(c.back() == std::string(32, 'a'));
+
+        c.resize(1000, std::string(32, 'd'));
+        REQUIRE(c.data() == data);
+        REQUIRE(c[999] == std::string(32, 'd'));
+        c.resize(2);
+
+        //
+        ecs::stable_vector<std::string> x{c};
+        REQUIRE(x == c);
+        REQUIRE(x.data() != c.data());
+
+        ecs::stable_vector<std::string> y{std::move(x)};
+        REQUIRE(y == c);
+        REQUIRE(x.empty());
+
+        x = y;
+        REQUIRE(x == y);
+}
+
+TEST_CASE("remap_vector", "[ecs::remap_vector]")
+{
+        ecs::remap_vector<std::unique_ptr<int>, 4096> c;
+
+        REQUIRE(c.empty());
+        REQUIRE(c.capacity() == 0);
+
+        // buffer grows past the threshold and becomes a mapping
+        for(int i = 0; i < 100000; ++i)
+                c.push_back(std::make_unique<int>(i));
+
+        REQUIRE(c.size() == 100000);
+        REQUIRE(c.capacity() * sizeof(std::unique_ptr<int>) % 4096 == 0);
+
+        auto check = [](const auto& x) {
+                for(std::size_t i = 0; i < x.size(); ++i)
+                        if(*x[i] != static_cast<int>(i))
+                                return false;
+
+                return true;
+        };
+
+        REQUIRE(check(c));
+
+        c.erase(c.begin() + 10, c.end());
+        REQUIRE(c.size() == 10);
+        REQUIRE(check(c));
+
+        // mapping is shrunk in place, and then replaced with a heap buffer
+        REQUIRE(c.shrink_to(2000));
+        REQUIRE(c.capacity() >= 2000);
+        REQUIRE(c.capacity() < 100000);
+        REQUIRE(check(c));
+
+        REQUIRE(c.shrink_to_fit());
+        REQUIRE(c.capacity() == 10);
+        REQUIRE(check(c));
+
+        //
+        ecs::remap_vector<std::unique_ptr<int>, 4096> x{std::move(c)};
+        REQUIRE(x.size() == 10);
+        REQUIRE(c.empty());
+        REQUIRE(check(x));
+
+        ecs::remap_vector<int> y;
+        y.assign({1, 2, 3});
+
+        ecs::remap_vector<int> z{y};
+        REQUIRE(z == y);
+
+        // element of a full container is pushed back
+        ecs::remap_vector<int, 4096> w;
+        for(int i = 0; i < 10000; ++i)
+                w.push_back(i + 1);
+
+        while(w.size() != w.capacity())
+                w.push_back(0);
+
+        auto n = w.size();
+        REQUIRE(w.push_back(w[0]) != w.end());
+        REQUIRE(w.size() == n + 1);
+        REQUIRE(w.back() == 1);
+
+        // element of a full container is inserted repeatedly
+        while(w.size() != w.capacity())
+                w.push_back(0);
+
+        n = w.size();
+        REQUIRE(w.insert(w.begin() + 1, 3, w[0]) != w.end());
+        REQUIRE(w.size() == n + 3);
+        REQUIRE(w[1] == 1);
+        REQUIRE(w[2] == 1);
+        REQUIRE(w[3] == 1);
+        REQUIRE(w[4] == 2);
+}
+
+//
+} // namespace mapped_storage_types_testing
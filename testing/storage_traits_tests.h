@@ -495,5 +495,47 @@ TEST_CASE("good_storage", "[ecs::storage_traits]")
         REQUIRE(call_tracker.swap_called);
 }
 
+TEST_CASE("growth policies", "[ecs::storage_traits]")
+{
+        using size = std::size_t;
+        constexpr size max = 1000;
+
+        static_assert(ecs::geometric_growth<>::next_capacity(size{10}, size{11}, max, 1) == 20);
+        static_assert(ecs::geometric_growth<>::next_capacity(size{10}, size{50}, max, 1) == 50);
+        static_assert(ecs::geometric_growth<>::next_capacity(size{600}, size{601}, max, 1) ==
+                      max);
+        static_assert(ecs::geometric_growth<3, 2>::next_capacity(size{10}, size{11}, max, 1) ==
+                      15);
+        static_assert(ecs::exact_growth::next_capacity(size{10}, size{11}, max, 1) == 11);
+
+        static_assert(ecs::size_class_growth<>::next_capacity(size{10}, size{11}, max, 1) == 20);
+        static_assert(ecs::size_class_growth<ecs::exact_growth>::next_capacity(
+                              size{0}, size{33}, max, 1) == 40);
+        static_assert(ecs::size_class_growth<ecs::exact_growth>::next_capacity(
+                              size{0}, size{100}, max, 4) == 112);
+
+        static_assert(ecs::page_growth<ecs::exact_growth>::next_capacity(
+                              size{0}, size{1}, max * 10, 4) == 1024);
+        static_assert(ecs::page_growth<ecs::exact_growth>::next_capacity(
+                              size{0}, size{1}, max, 4) == max);
+
+        // storage_traits clamp result of the policy to [n, max_size]
+        using traits = ecs::storage_traits<
+                ecs::allocator_aware_storage<ecs::vector_storage<int, std::allocator<int>>>>;
+        static_assert(std::is_same<traits::growth_policy, ecs::geometric_growth<>>::value);
+
+        ecs::vector<int, std::allocator<int>, ecs::exact_growth> c;
+        for(std::size_t i = 1; i <= 10; ++i)
+        {
+                c.push_back(0);
+                REQUIRE(c.capacity() == i);
+        }
+
+        ecs::vector<int, std::allocator<int>, ecs::geometric_growth<3, 2>> x;
+        x.assign(10, 0);
+        x.push_back(0);
+        REQUIRE(x.capacity() == 15);
+}
+
 //
 } // namespace storage_traits_testing
@@ -1 +1 @@
-#include "contiguous_container_tests.h"
+#include "gap_buffer_tests.h"